@@ -0,0 +1,423 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_JSON_HPP
+#define JSONCONS_ARENA_JSON_HPP
+
+#include <cstddef> // std::size_t, std::max_align_t
+#include <cstdint> // uintptr_t
+#include <memory> // std::unique_ptr
+#include <new> // placement new, ::operator new
+#include <istream> // std::basic_istream
+#include <type_traits>
+#include <utility> // std::move
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/decode_json.hpp>
+
+namespace jsoncons {
+
+    // json_arena
+    // A monotonic buffer. Memory is handed out from a chain of blocks that grow
+    // geometrically, deallocation does nothing, and all blocks are freed at once
+    // by release() or the destructor.
+
+    class json_arena
+    {
+        struct block_header
+        {
+            block_header* next;
+            std::size_t size;
+        };
+
+        static constexpr std::size_t header_size = (sizeof(block_header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        static constexpr std::size_t max_block_size = std::size_t(1) << 26;
+
+        block_header* head_;
+        char* current_;
+        char* end_;
+        char* initial_buffer_;
+        std::size_t initial_buffer_size_;
+        std::size_t initial_block_size_;
+        std::size_t next_block_size_;
+        std::size_t bytes_allocated_;
+    public:
+        explicit json_arena(std::size_t initial_block_size = 4096)
+            : head_(nullptr), current_(nullptr), end_(nullptr),
+              initial_buffer_(nullptr), initial_buffer_size_(0),
+              initial_block_size_(initial_block_size > 0 ? initial_block_size : 1),
+              next_block_size_(initial_block_size_),
+              bytes_allocated_(0)
+        {
+        }
+
+        // Allocations are served from buffer first, which must outlive the arena
+        json_arena(void* buffer, std::size_t size, std::size_t next_block_size = 4096)
+            : head_(nullptr), current_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + size),
+              initial_buffer_(static_cast<char*>(buffer)), initial_buffer_size_(size),
+              initial_block_size_(next_block_size > 0 ? next_block_size : 1),
+              next_block_size_(initial_block_size_),
+              bytes_allocated_(0)
+        {
+        }
+
+        json_arena(const json_arena&) = delete;
+        json_arena& operator=(const json_arena&) = delete;
+
+        ~json_arena() noexcept
+        {
+            free_blocks();
+        }
+
+        void* allocate(std::size_t n, std::size_t align = alignof(std::max_align_t))
+        {
+            char* p = align_up(current_, align);
+            if (p == nullptr || n > static_cast<std::size_t>(end_ - p))
+            {
+                p = new_block(n, align);
+            }
+            current_ = p + n;
+            bytes_allocated_ += n;
+            return p;
+        }
+
+        void deallocate(void*, std::size_t) noexcept
+        {
+        }
+
+        // Frees every block, in time proportional to the number of blocks.
+        // Anything allocated from the arena must not be used afterwards.
+        void release() noexcept
+        {
+            free_blocks();
+            current_ = initial_buffer_;
+            end_ = initial_buffer_ + initial_buffer_size_;
+            next_block_size_ = initial_block_size_;
+            bytes_allocated_ = 0;
+        }
+
+        // The number of bytes handed out since construction or the last release
+        std::size_t bytes_allocated() const
+        {
+            return bytes_allocated_;
+        }
+
+        // The number of bytes held in blocks obtained from operator new
+        std::size_t bytes_reserved() const
+        {
+            std::size_t total = 0;
+            for (block_header* b = head_; b != nullptr; b = b->next)
+            {
+                total += b->size;
+            }
+            return total;
+        }
+
+    private:
+        static char* align_up(char* p, std::size_t align)
+        {
+            if (p == nullptr)
+            {
+                return nullptr;
+            }
+            uintptr_t u = reinterpret_cast<uintptr_t>(p);
+            return p + ((align - (u & (align - 1))) & (align - 1));
+        }
+
+        char* new_block(std::size_t n, std::size_t align)
+        {
+            std::size_t needed = n + (align > alignof(std::max_align_t) ? align : 0);
+            std::size_t size = next_block_size_ > needed ? next_block_size_ : needed;
+            char* mem = static_cast<char*>(::operator new(header_size + size));
+            block_header* b = reinterpret_cast<block_header*>(mem);
+            b->next = head_;
+            b->size = header_size + size;
+            head_ = b;
+            end_ = mem + header_size + size;
+            if (next_block_size_ < max_block_size)
+            {
+                next_block_size_ *= 2;
+            }
+            return align_up(mem + header_size, align);
+        }
+
+        void free_blocks() noexcept
+        {
+            block_header* b = head_;
+            while (b != nullptr)
+            {
+                block_header* next = b->next;
+                ::operator delete(static_cast<void*>(b));
+                b = next;
+            }
+            head_ = nullptr;
+        }
+    };
+
+    // arena_allocator
+    // A stateful allocator that draws from a json_arena. It propagates on copy
+    // assignment, move assignment and swap, and copies of a container keep
+    // the arena of the original. A default constructed arena_allocator has no
+    // arena and uses operator new and operator delete.
+
+    template <class T>
+    class arena_allocator
+    {
+        template <class U>
+        friend class arena_allocator;
+
+        json_arena* arena_;
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        template <class U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+
+        arena_allocator() noexcept
+            : arena_(nullptr)
+        {
+        }
+
+        arena_allocator(json_arena& arena) noexcept
+            : arena_(std::addressof(arena))
+        {
+        }
+
+        arena_allocator(const arena_allocator&) noexcept = default;
+        arena_allocator& operator=(const arena_allocator&) noexcept = default;
+
+        template <class U>
+        arena_allocator(const arena_allocator<U>& other) noexcept
+            : arena_(other.arena_)
+        {
+        }
+
+        T* allocate(size_type n)
+        {
+            if (arena_ == nullptr)
+            {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_type n) noexcept
+        {
+            if (arena_ == nullptr)
+            {
+                ::operator delete(static_cast<void*>(p));
+            }
+            else
+            {
+                arena_->deallocate(p, n * sizeof(T));
+            }
+        }
+
+        json_arena* arena() const noexcept
+        {
+            return arena_;
+        }
+
+        template <class U>
+        friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+        {
+            return lhs.arena() == rhs.arena();
+        }
+
+        template <class U>
+        friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+        {
+            return lhs.arena() != rhs.arena();
+        }
+    };
+
+    using arena_json = basic_json<char,sorted_policy,arena_allocator<char>>;
+    using arena_ojson = basic_json<char,order_preserving_policy,arena_allocator<char>>;
+    using arena_wjson = basic_json<wchar_t,sorted_policy,arena_allocator<char>>;
+    using arena_wojson = basic_json<wchar_t,order_preserving_policy,arena_allocator<char>>;
+
+namespace detail {
+
+    template <class T,class Enable=void>
+    struct is_arena_json : std::false_type {};
+
+    template <class T>
+    struct is_arena_json<T,
+        typename std::enable_if<type_traits::is_basic_json<T>::value &&
+                                std::is_same<typename T::allocator_type,
+                                             arena_allocator<typename T::allocator_type::value_type>>::value>::type
+    > : std::true_type {};
+
+} // namespace detail
+
+    // decode_json with an arena
+    // The result, and the work areas of the reader and decoder, are allocated from arena
+
+    template <class T,class Source>
+    typename std::enable_if<detail::is_arena_json<T>::value &&
+                            type_traits::is_sequence_of<Source,typename T::char_type>::value,T>::type
+    decode_json(json_arena& arena,
+                const Source& s,
+                const basic_json_decode_options<typename Source::value_type>& options = basic_json_decode_options<typename Source::value_type>())
+    {
+        using char_type = typename Source::value_type;
+        using temp_allocator_type = arena_allocator<char>;
+
+        temp_allocator_type alloc(arena);
+        json_decoder<T,temp_allocator_type> decoder(result_allocator_arg, alloc, alloc);
+        basic_json_reader<char_type,string_source<char_type>,temp_allocator_type> reader(s, decoder, options, alloc);
+        reader.read();
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(conv_errc::conversion_failed, reader.line(), reader.column()));
+        }
+        return decoder.get_result();
+    }
+
+    template <class T,class CharT>
+    typename std::enable_if<detail::is_arena_json<T>::value,T>::type
+    decode_json(json_arena& arena,
+                std::basic_istream<CharT>& is,
+                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+    {
+        using temp_allocator_type = arena_allocator<char>;
+
+        temp_allocator_type alloc(arena);
+        json_decoder<T,temp_allocator_type> decoder(result_allocator_arg, alloc, alloc);
+        basic_json_reader<CharT,stream_source<CharT>,temp_allocator_type> reader(is, decoder, options, alloc);
+        reader.read();
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(conv_errc::conversion_failed, reader.line(), reader.column()));
+        }
+        return decoder.get_result();
+    }
+
+    // basic_arena_json_document
+    // Owns an arena and a root value allocated from it. The destructor releases
+    // the arena without running the destructors of the values in it, so that
+    // a document of any size is freed in time proportional to the number of
+    // arena blocks. Values stored in the document must be allocated from
+    // get_allocator(); memory obtained from a default constructed allocator
+    // is not reclaimed.
+
+    template <class Json>
+    class basic_arena_json_document
+    {
+        static_assert(detail::is_arena_json<Json>::value, "Json must be a basic_json with an arena_allocator");
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using allocator_type = typename Json::allocator_type;
+    private:
+        std::unique_ptr<json_arena> arena_;
+        Json* root_;
+    public:
+        explicit basic_arena_json_document(std::size_t initial_block_size = 4096)
+            : arena_(new json_arena(initial_block_size)), root_(nullptr)
+        {
+            root_ = make_root(Json(null_type(), semantic_tag::none));
+        }
+
+        basic_arena_json_document(const basic_arena_json_document&) = delete;
+        basic_arena_json_document& operator=(const basic_arena_json_document&) = delete;
+
+        basic_arena_json_document(basic_arena_json_document&& other) noexcept
+            : arena_(std::move(other.arena_)), root_(other.root_)
+        {
+            other.root_ = nullptr;
+        }
+
+        basic_arena_json_document& operator=(basic_arena_json_document&& other) noexcept
+        {
+            if (this != &other)
+            {
+                arena_ = std::move(other.arena_);
+                root_ = other.root_;
+                other.root_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~basic_arena_json_document() noexcept = default;
+
+        static basic_arena_json_document parse(const string_view_type& s,
+                                               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                               std::size_t initial_block_size = 4096)
+        {
+            basic_arena_json_document doc(initial_block_size);
+            doc.root_ = doc.make_root(decode_json<Json>(*doc.arena_, s, options));
+            return doc;
+        }
+
+        static basic_arena_json_document parse(std::basic_istream<char_type>& is,
+                                               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                               std::size_t initial_block_size = 4096)
+        {
+            basic_arena_json_document doc(initial_block_size);
+            doc.root_ = doc.make_root(decode_json<Json>(*doc.arena_, is, options));
+            return doc;
+        }
+
+        Json& root()
+        {
+            return *root_;
+        }
+
+        const Json& root() const
+        {
+            return *root_;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(*arena_);
+        }
+
+        json_arena& arena()
+        {
+            return *arena_;
+        }
+
+        const json_arena& arena() const
+        {
+            return *arena_;
+        }
+
+        // Releases everything allocated from the arena and resets the root to null
+        void clear()
+        {
+            arena_->release();
+            root_ = make_root(Json(null_type(), semantic_tag::none));
+        }
+
+    private:
+        Json* make_root(Json&& val)
+        {
+            void* p = arena_->allocate(sizeof(Json), alignof(Json));
+            return ::new(p) Json(std::move(val));
+        }
+    };
+
+    using arena_json_document = basic_arena_json_document<arena_json>;
+    using arena_ojson_document = basic_arena_json_document<arena_ojson>;
+    using arena_wjson_document = basic_arena_json_document<arena_wjson>;
+    using arena_wojson_document = basic_arena_json_document<arena_wojson>;
+
+} // namespace jsoncons
+
+#endif
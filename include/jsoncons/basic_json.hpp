@@ -260,6 +260,17 @@ namespace jsoncons {
         using parse_error_handler_type = default_json_parsing;
     };
 
+    struct hash_indexed_policy
+    {
+        template <class KeyT,class Json>
+        using object = hash_indexed_json_object<KeyT,Json,std::vector>;
+
+        template <class Json>
+        using array = json_array<Json,std::vector>;
+
+        using parse_error_handler_type = default_json_parsing;
+    };
+
     #if !defined(JSONCONS_NO_DEPRECATED)
         using preserve_order_policy = order_preserving_policy;
     #endif
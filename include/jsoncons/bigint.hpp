@@ -21,6 +21,7 @@
 #include <initializer_list> // std::initializer_list
 #include <type_traits> // std::enable_if
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/decimal_digits.hpp>
 
 namespace jsoncons {
 
@@ -979,51 +980,44 @@ public:
     template <typename Ch, typename Traits, typename Alloc>
     void write_string(std::basic_string<Ch,Traits,Alloc>& data) const
     {
-        basic_bigint<Allocator> v(*this);
-
-        size_t len = (v.length() * basic_type_bits / 3) + 2;
-        data.reserve(len);
-
-        static uint64_t p10 = 1;
-        static uint64_t ip10 = 0;
-
-        if ( v.length() == 0 )
+        if (length() == 0)
         {
             data.push_back('0');
+            return;
         }
-        else
-        {
-            uint64_t r;
-            if ( p10 == 1 )
-            {
-                while ( p10 <= (std::numeric_limits<uint64_t>::max)()/10 )
-                {
-                    p10 *= 10;
-                    ip10++;
-                }
-            }                     
-            // p10 is max unsigned power of 10
-            basic_bigint<Allocator> R;
-            basic_bigint<Allocator> LP10 = p10; // LP10 = p10 = ::pow(10, ip10)
 
-            do
-            {
-                v.divide( LP10, v, R, true );
-                r = (R.length() ? R.data()[0] : 0);
-                for ( size_type j=0; j < ip10; j++ )
-                {
-                    data.push_back(char(r % 10 + '0'));
-                    r /= 10;
-                    if ( r + v.length() == 0 )
-                        break;
-                }
-            } 
-            while ( v.length() );
-            if (is_negative())
-            {
-                data.push_back('-');
-            }
-            std::reverse(data.begin(),data.end());
+        // Divides by 10^19, the largest power of 10 in a uint64_t, collecting the 
+        // remainders, least significant first. Each is written as 19 digits, two at a time,
+        // except the most significant, which is written without leading zeros.
+        const uint64_t p10 = 10000000000000000000u;
+        const std::size_t ip10 = 19;
+
+        basic_bigint<Allocator> v(*this);
+        basic_bigint<Allocator> R;
+        basic_bigint<Allocator> LP10 = p10;
+        std::vector<uint64_t> chunks;
+        chunks.reserve((length() * basic_type_bits / 3) / ip10 + 1);
+        do
+        {
+            v.divide( LP10, v, R, true );
+            chunks.push_back(R.length() ? R.data()[0] : 0);
+        } 
+        while ( v.length() );
+
+        std::size_t first_count = detail::count_decimal_digits(chunks.back());
+        std::size_t offset = data.size();
+        data.resize(offset + (is_negative() ? 1 : 0) + first_count + (chunks.size() - 1) * ip10);
+        Ch* p = &data[offset];
+        if (is_negative())
+        {
+            *p++ = '-';
+        }
+        detail::write_decimal_digits(chunks.back(), p, first_count);
+        p += first_count;
+        for (std::size_t i = chunks.size() - 1; i-- > 0; )
+        {
+            detail::write_decimal_digits(chunks[i], p, ip10);
+            p += ip10;
         }
     }
 
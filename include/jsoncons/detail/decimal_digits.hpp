@@ -0,0 +1,87 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_DECIMAL_DIGITS_HPP
+#define JSONCONS_DETAIL_DECIMAL_DIGITS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace jsoncons { namespace detail {
+
+    // "00" to "99", two characters for each of the numbers 0 to 99
+
+    inline
+    const char* digit_pairs()
+    {
+        static const char table[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+        return table;
+    }
+
+    // The number of decimal digits in value, one for zero
+
+    inline
+    std::size_t count_decimal_digits(uint64_t value)
+    {
+        std::size_t count = 1;
+        for (;;)
+        {
+            if (value < 10)
+            {
+                return count;
+            }
+            if (value < 100)
+            {
+                return count + 1;
+            }
+            if (value < 1000)
+            {
+                return count + 2;
+            }
+            if (value < 10000)
+            {
+                return count + 3;
+            }
+            value /= 10000u;
+            count += 4;
+        }
+    }
+
+    // Writes the count least significant decimal digits of value to [first,first+count),
+    // two at a time from the end, padding with zeros if value has fewer digits
+
+    template <class CharT>
+    void write_decimal_digits(uint64_t value, CharT* first, std::size_t count)
+    {
+        const char* pairs = digit_pairs();
+        CharT* p = first + count;
+        while (p - first >= 2)
+        {
+            std::size_t i = static_cast<std::size_t>(value % 100) * 2;
+            value /= 100;
+            *--p = static_cast<CharT>(pairs[i + 1]);
+            *--p = static_cast<CharT>(pairs[i]);
+        }
+        if (p != first)
+        {
+            *--p = static_cast<CharT>('0' + value % 10);
+        }
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -18,7 +18,10 @@
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/bigint.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
 #include <cctype>
+#include <cstring> // std::memcpy
 
 namespace jsoncons { namespace detail {
 
@@ -910,223 +913,499 @@ base16_to_integer(const CharT* s, std::size_t length, T& n)
 }
 
 
-#if defined(JSONCONS_HAS_STD_FROM_CHARS)
+// to_double
 
-class chars_to
+template <class CharT>
+struct to_double_result
 {
-public:
+    const CharT* ptr;
+    std::errc ec;
 
-    char get_decimal_point() const
+    constexpr explicit operator bool() const noexcept
     {
-        return '.';
+        return ec == std::errc();
     }
+};
 
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t len) const
+template <class CharT>
+bool is_decimal_digit(CharT c)
+{
+    return c >= '0' && c <= '9';
+}
+
+template <class CharT>
+int hex_digit_value(CharT c)
+{
+    if (c >= '0' && c <= '9')
     {
-        double val = 0;
-        const auto res = std::from_chars(s, s+len, val);
-        if (res.ec != std::errc())
-        {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert chars to double failed"));
-        }
-        return val;
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
     }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
 
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t len) const
+template <class CharT>
+bool starts_with_ignore_case(const CharT* first, const CharT* last, const char* lower)
+{
+    for (; *lower != 0; ++first, ++lower)
     {
-        std::string input(len,'0');
-        for (size_t i = 0; i < len; ++i)
+        if (first == last || (*first != *lower && *first != (*lower - ('a' - 'A'))))
         {
-            input[i] = static_cast<char>(s[i]);
+            return false;
         }
+    }
+    return true;
+}
 
-        double val = 0;
-        const auto res = std::from_chars(input.data(), input.data() + len, val);
-        if (res.ec != std::errc())
+inline
+double bits_to_double(uint64_t bits)
+{
+    double val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+inline
+uint64_t double_to_bits(double val)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(val));
+    return bits;
+}
+
+// Rounds mantissa * 2^exp2 to the nearest double, ties to even.
+// sticky indicates nonzero bits below the mantissa.
+inline
+uint64_t binary_to_double_bits(uint64_t mantissa, int64_t exp2, bool sticky)
+{
+    if (mantissa == 0)
+    {
+        return 0;
+    }
+    int lz = leading_zeros(mantissa);
+    mantissa <<= lz;
+    exp2 -= lz;
+
+    // mantissa is now in [2^63,2^64), the value is 1.f * 2^(exp2 + 63)
+    int64_t biased = exp2 + 63 + 1023;
+    if (biased >= 0x7FF)
+    {
+        return uint64_t(0x7FF) << 52;
+    }
+    int64_t shift = biased > 0 ? 11 : 12 - biased;
+    if (shift > 64)
+    {
+        return 0;
+    }
+    uint64_t kept = shift == 64 ? 0 : mantissa >> shift;
+    uint64_t rest = shift == 64 ? mantissa : mantissa & ((uint64_t(1) << shift) - 1);
+    uint64_t half = uint64_t(1) << (shift - 1);
+    if (rest > half || (rest == half && (sticky || (kept & 1) != 0)))
+    {
+        ++kept;
+    }
+    if (biased <= 0)
+    {
+        // A carry into the hidden bit makes the number normal, with exponent 1
+        return kept;
+    }
+    if (kept == (uint64_t(1) << 53))
+    {
+        kept >>= 1;
+        ++biased;
+        if (biased >= 0x7FF)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert chars to double failed"));
+            return uint64_t(0x7FF) << 52;
         }
-        return val;
     }
-};
-#elif defined(JSONCONS_HAS_MSC_STRTOD_L)
+    return (kept & ((uint64_t(1) << 52) - 1)) | (uint64_t(biased) << 52);
+}
 
-class chars_to
+// Compares digits * 10^exp10 with the halfway point between the positive
+// double with bits and its successor, returns -1, 0 or 1
+template <class CharT>
+int compare_with_halfway(const CharT* digits_first, const CharT* digits_last, int64_t exp10, uint64_t bits)
 {
-private:
-    _locale_t locale_;
-public:
-    chars_to()
+    // At most 768 significant digits can affect rounding, 
+    // beyond that a nonzero digit only needs to be noted
+    constexpr std::size_t max_digits = 800;
+
+    bigint lhs;
+    uint64_t chunk = 0;
+    uint64_t chunk_scale = 1;
+    std::size_t count = 0;
+    bool truncated = false;
+    bool after_point = false;
+    for (const CharT* p = digits_first; p < digits_last; ++p)
     {
-        locale_ = _create_locale(LC_NUMERIC, "C");
+        if (*p == '.')
+        {
+            after_point = true;
+            continue;
+        }
+        uint64_t d = static_cast<uint64_t>(*p - '0');
+        if (count == 0 && d == 0)
+        {
+            if (after_point)
+            {
+                --exp10;
+            }
+            continue;
+        }
+        if (count < max_digits)
+        {
+            chunk = chunk * 10 + d;
+            chunk_scale *= 10;
+            if (chunk_scale == uint64_t(10000000000000000000u))
+            {
+                lhs *= chunk_scale;
+                lhs += bigint(chunk);
+                chunk = 0;
+                chunk_scale = 1;
+            }
+            ++count;
+            if (after_point)
+            {
+                --exp10;
+            }
+        }
+        else 
+        {
+            if (!after_point)
+            {
+                ++exp10;
+            }
+            if (d != 0)
+            {
+                truncated = true;
+            }
+        }
     }
-    ~chars_to() noexcept
+    if (truncated)
     {
-        _free_locale(locale_);
+        chunk = chunk * 10 + 1;
+        chunk_scale *= 10;
+        --exp10;
     }
+    lhs *= chunk_scale;
+    lhs += bigint(chunk);
 
-    chars_to(const chars_to&)
+    int64_t biased = static_cast<int64_t>(bits >> 52);
+    uint64_t m = bits & ((uint64_t(1) << 52) - 1);
+    int64_t exp2;
+    if (biased == 0)
     {
-        locale_ = _create_locale(LC_NUMERIC, "C");
+        exp2 = -1074;
     }
-
-    chars_to& operator=(const chars_to&) 
+    else
     {
-        // Don't assign locale
-        return *this;
+        m |= uint64_t(1) << 52;
+        exp2 = biased - 1075;
     }
+    // halfway = (2m + 1) * 2^(exp2 - 1)
+    bigint rhs(2*m + 1);
+    exp2 -= 1;
 
-    char get_decimal_point() const
+    if (exp10 >= 0)
     {
-        return '.';
+        lhs *= power(bigint(5), static_cast<unsigned>(exp10));
     }
+    else
+    {
+        rhs *= power(bigint(5), static_cast<unsigned>(-exp10));
+    }
+    if (exp10 > exp2)
+    {
+        lhs <<= static_cast<uint64_t>(exp10 - exp2);
+    }
+    else if (exp2 > exp10)
+    {
+        rhs <<= static_cast<uint64_t>(exp2 - exp10);
+    }
+    return lhs.compare(rhs);
+}
 
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+// Parses a hexadecimal floating point number, first points past "0x"
+template <class CharT>
+const CharT* hexstr_to_double(const CharT* first, const CharT* last, uint64_t& bits)
+{
+    uint64_t mantissa = 0;
+    int64_t exp2 = 0;
+    bool sticky = false;
+    bool has_digits = false;
+
+    const CharT* p = first;
+    for (; p < last && hex_digit_value(*p) >= 0; ++p)
     {
-        CharT *end = nullptr;
-        double val = _strtod_l(s, &end, locale_);
-        if (s == end)
+        has_digits = true;
+        if ((mantissa >> 60) == 0)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
+            mantissa = (mantissa << 4) | static_cast<uint64_t>(hex_digit_value(*p));
+        }
+        else
+        {
+            exp2 += 4;
+            sticky = sticky || *p != '0';
         }
-        return val;
     }
-
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    if (p < last && *p == '.')
     {
-        CharT *end = nullptr;
-        double val = _wcstod_l(s, &end, locale_);
-        if (s == end)
+        ++p;
+        for (; p < last && hex_digit_value(*p) >= 0; ++p)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
+            has_digits = true;
+            if ((mantissa >> 60) == 0)
+            {
+                mantissa = (mantissa << 4) | static_cast<uint64_t>(hex_digit_value(*p));
+                exp2 -= 4;
+            }
+            else
+            {
+                sticky = sticky || *p != '0';
+            }
         }
-        return val;
     }
-};
-
-#elif defined(JSONCONS_HAS_STRTOLD_L)
-
-class chars_to
-{
-private:
-    locale_t locale_;
-public:
-    chars_to()
+    if (!has_digits)
     {
-        locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+        return first;
     }
-    ~chars_to() noexcept
+    if (p < last && (*p == 'p' || *p == 'P'))
     {
-        freelocale(locale_);
+        const CharT* q = p + 1;
+        bool negative = false;
+        if (q < last && (*q == '+' || *q == '-'))
+        {
+            negative = *q == '-';
+            ++q;
+        }
+        if (q < last && is_decimal_digit(*q))
+        {
+            int64_t e = 0;
+            for (; q < last && is_decimal_digit(*q); ++q)
+            {
+                if (e < 100000)
+                {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            exp2 += negative ? -e : e;
+            p = q;
+        }
     }
+    bits = binary_to_double_bits(mantissa, exp2, sticky);
+    return p;
+}
 
-    chars_to(const chars_to&)
+// Converts the longest prefix of [s, s+length) that forms a number to the nearest double, 
+// accepting what strtod accepts in the "C" locale: leading whitespace, an optional sign, 
+// and a decimal number, a hexadecimal number prefixed by "0x", "inf", "infinity" or "nan".
+// Out of range values become infinity or zero.
+template <class CharT>
+to_double_result<CharT> to_double(const CharT* s, std::size_t length, double& val)
+{
+    const CharT* first = s;
+    const CharT* last = s + length;
+    const CharT* p = first;
+
+    while (p < last && (*p == ' ' || (*p >= '\t' && *p <= '\r')))
     {
-        locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+        ++p;
     }
-
-    chars_to& operator=(const chars_to&) 
+    bool negative = false;
+    if (p < last && (*p == '+' || *p == '-'))
     {
-        return *this;
+        negative = *p == '-';
+        ++p;
     }
+    uint64_t sign = negative ? uint64_t(1) << 63 : 0;
 
-    char get_decimal_point() const
+    if (p < last && !is_decimal_digit(*p) && *p != '.')
     {
-        return '.';
+        if (starts_with_ignore_case(p, last, "inf"))
+        {
+            p += starts_with_ignore_case(p, last, "infinity") ? 8 : 3;
+            val = bits_to_double(sign | (uint64_t(0x7FF) << 52));
+            return to_double_result<CharT>{p, std::errc()};
+        }
+        if (starts_with_ignore_case(p, last, "nan"))
+        {
+            val = negative ? -std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::quiet_NaN();
+            return to_double_result<CharT>{p + 3, std::errc()};
+        }
+        val = 0;
+        return to_double_result<CharT>{first, std::errc::invalid_argument};
     }
-
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    if (last - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
     {
-        char *end = nullptr;
-        double val = strtold_l(s, &end, locale_);
-        if (s == end)
+        uint64_t bits = 0;
+        const CharT* q = hexstr_to_double(p + 2, last, bits);
+        if (q != p + 2)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
+            val = bits_to_double(sign | bits);
+            return to_double_result<CharT>{q, std::errc()};
         }
-        return val;
+        // Only the "0" is a number
+        val = negative ? -0.0 : 0.0;
+        return to_double_result<CharT>{p + 1, std::errc()};
     }
 
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    // Up to 19 significant digits are accumulated in w
+    const CharT* digits_first = p;
+    uint64_t w = 0;
+    int digit_count = 0;
+    int64_t exp10 = 0;
+    bool truncated = false;
+    bool has_digits = false;
+
+    for (; p < last && is_decimal_digit(*p); ++p)
     {
-        CharT *end = nullptr;
-        double val = wcstold_l(s, &end, locale_);
-        if (s == end)
+        has_digits = true;
+        uint64_t d = static_cast<uint64_t>(*p - '0');
+        if (w == 0 && d == 0)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
+            continue;
+        }
+        if (digit_count < 19)
+        {
+            w = w * 10 + d;
+            ++digit_count;
+        }
+        else
+        {
+            ++exp10;
+            truncated = truncated || d != 0;
         }
-        return val;
     }
-};
+    if (p < last && *p == '.')
+    {
+        const CharT* q = p + 1;
+        for (; q < last && is_decimal_digit(*q); ++q)
+        {
+            has_digits = true;
+            uint64_t d = static_cast<uint64_t>(*q - '0');
+            if (w == 0 && d == 0)
+            {
+                --exp10;
+                continue;
+            }
+            if (digit_count < 19)
+            {
+                w = w * 10 + d;
+                ++digit_count;
+                --exp10;
+            }
+            else
+            {
+                truncated = truncated || d != 0;
+            }
+        }
+        if (has_digits)
+        {
+            p = q;
+        }
+    }
+    if (!has_digits)
+    {
+        val = 0;
+        return to_double_result<CharT>{first, std::errc::invalid_argument};
+    }
+    const CharT* digits_last = p;
 
-#else
-class chars_to
-{
-private:
-    std::vector<char> buffer_;
-    char decimal_point_;
-public:
-    chars_to()
-        : buffer_()
+    int64_t exp_part = 0;
+    if (p < last && (*p == 'e' || *p == 'E'))
     {
-        struct lconv * lc = localeconv();
-        if (lc != nullptr && lc->decimal_point[0] != 0)
+        const CharT* q = p + 1;
+        bool negative_exp = false;
+        if (q < last && (*q == '+' || *q == '-'))
         {
-            decimal_point_ = lc->decimal_point[0];    
+            negative_exp = *q == '-';
+            ++q;
         }
-        else
+        if (q < last && is_decimal_digit(*q))
         {
-            decimal_point_ = '.'; 
+            for (; q < last && is_decimal_digit(*q); ++q)
+            {
+                if (exp_part < 100000)
+                {
+                    exp_part = exp_part * 10 + (*q - '0');
+                }
+            }
+            if (negative_exp)
+            {
+                exp_part = -exp_part;
+            }
+            p = q;
         }
-        buffer_.reserve(100);
     }
 
-    chars_to(const chars_to&) = default;
-    chars_to& operator=(const chars_to&) = default;
+    if (w == 0)
+    {
+        val = negative ? -0.0 : 0.0;
+        return to_double_result<CharT>{p, std::errc()};
+    }
+    exp10 += exp_part;
 
-    char get_decimal_point() const
+    // Exact when w and 10^|exp10| are exactly representable
+    static constexpr double exact_powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (!truncated && w <= (uint64_t(1) << 53) && exp10 >= -22 && exp10 <= 22)
     {
-        return decimal_point_;
+        double d = static_cast<double>(w);
+        d = exp10 < 0 ? d / exact_powers_of_ten[-exp10] : d * exact_powers_of_ten[exp10];
+        val = negative ? -d : d;
+        return to_double_result<CharT>{p, std::errc()};
     }
 
-    template <class CharT>
-    typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    uint64_t bits = eisel_lemire(exp10, w);
+    if (truncated)
     {
-        CharT *end = nullptr;
-        double val = strtod(s, &end);
-        if (s == end)
+        // The value lies in [w*10^exp10, (w+1)*10^exp10)
+        uint64_t upper = eisel_lemire(exp10, w + 1);
+        while (bits != upper)
         {
-            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
+            int cmp = compare_with_halfway(digits_first, digits_last, exp_part, bits);
+            if (cmp < 0 || (cmp == 0 && (bits & 1) == 0))
+            {
+                break;
+            }
+            ++bits;
         }
-        return val;
+    }
+    val = bits_to_double(sign | bits);
+    return to_double_result<CharT>{p, std::errc()};
+}
+
+// chars_to
+// Converts a number in the "C" locale to a double, the decimal point is always '.'
+
+class chars_to
+{
+public:
+
+    char get_decimal_point() const
+    {
+        return '.';
     }
 
     template <class CharT>
-    typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    double operator()(const CharT* s, std::size_t length) const
     {
-        CharT *end = nullptr;
-        double val = wcstod(s, &end);
-        if (s == end)
+        double val = 0;
+        auto result = to_double(s, length, val);
+        if (!result)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
         }
         return val;
     }
 };
-#endif
 
 }}
 
@@ -0,0 +1,183 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+/*
+Implements the Schubfach algorithm for finding the shortest decimal
+representation of a double that rounds back to it, as described in
+Raffaello Giulietti, "The Schubfach way to render doubles", 2020.
+Unlike Grisu3, it never fails, and needs no fallback.
+*/
+
+#ifndef JSONCONS_DETAIL_SCHUBFACH_HPP
+#define JSONCONS_DETAIL_SCHUBFACH_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
+#include <jsoncons/detail/decimal_digits.hpp>
+
+namespace jsoncons { namespace detail {
+
+    // floor(log10(2^e)), for -2620 <= e <= 2620
+    inline
+    int floor_log10_pow2(int e)
+    {
+        return (e * 315653) >> 20;
+    }
+
+    // floor(log10(3/4 * 2^e)), for -2985 <= e <= 2936
+    inline
+    int floor_log10_three_quarters_pow2(int e)
+    {
+        return (e * 315653 - 131237) >> 20;
+    }
+
+    // floor(log2(10^e)), for -1233 <= e <= 1233
+    inline
+    int floor_log2_pow10(int e)
+    {
+        return (e * 1741647) >> 19;
+    }
+
+    // 10^e as a 128 bit significand g, with 10^e * 2^-r < g <= 10^e * 2^-r + 1
+    inline
+    uint128_parts schubfach_pow10(int e)
+    {
+        const std::size_t index = 2 * static_cast<std::size_t>(e - pow5_128_min_exponent);
+        uint128_parts g;
+        g.high = pow5_128[index];
+        g.low = pow5_128[index + 1];
+        // The table entries for -27 <= e < 0 are already rounded up
+        if (e >= 0 || e < -27)
+        {
+            ++g.low;
+            if (g.low == 0)
+            {
+                ++g.high;
+            }
+        }
+        return g;
+    }
+
+    // floor(g * cp / 2^128), with the low bit set if the quotient is inexact
+    inline
+    uint64_t round_to_odd(const uint128_parts& g, uint64_t cp)
+    {
+        uint128_parts x = full_multiplication(g.low, cp);
+        uint128_parts y = full_multiplication(g.high, cp);
+        uint64_t z = y.low + x.high;
+        uint64_t z1 = y.high + (z < y.low ? 1 : 0);
+        return z1 | (z > 1 ? 1 : 0);
+    }
+
+    // Writes the shortest digits that round to the finite, positive double v
+    // to buffer (at least 17 chars), with v = digits * 10^k. When there is more
+    // than one shortest candidate, the one closest to v is chosen.
+    inline
+    void schubfach(double v, char* buffer, int* length, int* k)
+    {
+        constexpr int mantissa_explicit_bits = 52;
+        constexpr int exponent_bias = 1075;
+
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(v));
+        const uint64_t ieee_mantissa = bits & ((uint64_t(1) << mantissa_explicit_bits) - 1);
+        const int ieee_exponent = static_cast<int>(bits >> mantissa_explicit_bits) & 0x7FF;
+
+        uint64_t c;
+        int q;
+        if (ieee_exponent != 0)
+        {
+            c = (uint64_t(1) << mantissa_explicit_bits) | ieee_mantissa;
+            q = ieee_exponent - exponent_bias;
+        }
+        else
+        {
+            c = ieee_mantissa;
+            q = 1 - exponent_bias;
+        }
+
+        uint64_t digits;
+        int exp10;
+
+        if (q <= 0 && q >= -mantissa_explicit_bits && (c & ((uint64_t(1) << -q) - 1)) == 0)
+        {
+            // Integers below 2^53 are their own shortest representation
+            digits = c >> -q;
+            exp10 = 0;
+        }
+        else
+        {
+            const bool is_even = (c & 1) == 0;
+            const bool lower_boundary_is_closer = ieee_mantissa == 0 && ieee_exponent > 1;
+
+            // The rounding interval of v, in units of 2^(q-2)
+            const uint64_t cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+            const uint64_t cb = 4 * c;
+            const uint64_t cbr = 4 * c + 2;
+
+            exp10 = lower_boundary_is_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+            const int h = q + floor_log2_pow10(-exp10) + 1;
+            const uint128_parts g = schubfach_pow10(-exp10);
+
+            // The interval and v, scaled by 4 * 10^-exp10
+            const uint64_t vbl = round_to_odd(g, cbl << h);
+            const uint64_t vb = round_to_odd(g, cb << h);
+            const uint64_t vbr = round_to_odd(g, cbr << h);
+
+            const uint64_t lower = vbl + (is_even ? 0 : 1);
+            const uint64_t upper = vbr - (is_even ? 0 : 1);
+
+            const uint64_t s = vb / 4;
+            bool found = false;
+            if (s >= 10)
+            {
+                // One digit fewer
+                const uint64_t sp = s / 10;
+                const bool up_inside = lower <= 40 * sp;
+                const bool wp_inside = 40 * sp + 40 <= upper;
+                if (up_inside != wp_inside)
+                {
+                    digits = sp + (wp_inside ? 1 : 0);
+                    ++exp10;
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                const bool u_inside = lower <= 4 * s;
+                const bool w_inside = 4 * s + 4 <= upper;
+                if (u_inside != w_inside)
+                {
+                    digits = s + (w_inside ? 1 : 0);
+                }
+                else
+                {
+                    // Both or neither of s and s+1 are inside, pick the closer
+                    const uint64_t mid = 4 * s + 2;
+                    const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+                    digits = s + (round_up ? 1 : 0);
+                }
+            }
+        }
+
+        while (digits % 10 == 0)
+        {
+            digits /= 10;
+            ++exp10;
+        }
+
+        std::size_t n = count_decimal_digits(digits);
+        write_decimal_digits(digits, buffer, n);
+        *length = static_cast<int>(n);
+        *k = exp10;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,926 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_HPP
+#define JSONCONS_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memmove
+#include <type_traits>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/config/binary_config.hpp>
+
+// Define JSONCONS_NO_SIMD to force the portable scalar code paths
+
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#  endif
+#  if defined(JSONCONS_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define JSONCONS_HAS_AVX2_DISPATCH 1
+#  endif
+#endif
+
+#if defined(JSONCONS_HAS_SSE2)
+#  include <emmintrin.h>
+#endif
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#  include <immintrin.h>
+#  define JSONCONS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    inline
+    unsigned count_trailing_zeros(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(mask));
+    #else
+        unsigned n = 0;
+        while ((mask & 1u) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    unsigned count_trailing_zeros(uint64_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+    #else
+        unsigned n = 0;
+        while ((mask & 1u) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    unsigned popcount(uint64_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(mask));
+    #else
+        unsigned n = 0;
+        while (mask != 0)
+        {
+            mask &= mask - 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // Each bit i of the result is the xor of bits 0..i of x
+    inline
+    uint64_t prefix_xor(uint64_t x)
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    // Returns the characters that follow an unescaped backslash. prev_escaped is 1 if the 
+    // first character of the block is escaped by a backslash at the end of the previous block,
+    // on return it is set for the next block.
+    inline
+    uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped)
+    {
+        uint64_t escaped = prev_escaped;
+        backslash &= ~prev_escaped;
+        prev_escaped = 0;
+        while (backslash != 0)
+        {
+            unsigned i = count_trailing_zeros(backslash);
+            if (i == 63)
+            {
+                prev_escaped = 1;
+                break;
+            }
+            escaped |= uint64_t(1) << (i + 1);
+            backslash &= ~(uint64_t(3) << i);
+        }
+        return escaped;
+    }
+
+    // cpu_supports_avx2
+
+    inline
+    bool cpu_supports_avx2()
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        static const bool supported = __builtin_cpu_supports("avx2") != 0;
+        return supported;
+    #else
+        return false;
+    #endif
+    }
+
+    // find_string_special
+    //
+    // Returns a pointer to the first character in [first,last) that a JSON string
+    // scanner must look at: a quotation mark, a reverse solidus, or a control
+    // character (less than 0x20). Returns last if there is none.
+
+    template <class CharT>
+    const CharT* find_string_special_scalar(const CharT* first, const CharT* last)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        while (first < last)
+        {
+            uchar_type c = static_cast<uchar_type>(*first);
+            if (c < 0x20 || c == '\"' || c == '\\')
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    inline
+    const char* find_string_special_sse2(const char* first, const char* last)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1f);
+
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                           _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+        return find_string_special_scalar(first, last);
+    }
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    JSONCONS_TARGET_AVX2 inline
+    const char* find_string_special_avx2(const char* first, const char* last)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1f);
+
+        while (last - first >= 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                              _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+        return find_string_special_sse2(first, last);
+    }
+#endif
+
+    template <class CharT>
+    typename std::enable_if<!std::is_same<CharT,char>::value,const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last)
+    {
+        return find_string_special_scalar(first, last);
+    }
+
+    template <class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value,const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_supports_avx2())
+        {
+            return find_string_special_avx2(first, last);
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        return find_string_special_sse2(first, last);
+    #else
+        return find_string_special_scalar(first, last);
+    #endif
+    }
+
+    // find_char_to_escape
+    //
+    // Returns a pointer to the first character in [first,last) that a JSON encoder must
+    // escape: a quotation mark, a reverse solidus, a control character (less than 0x20, 
+    // or 0x7f), a solidus if escape_solidus is set, or a non-ASCII character if 
+    // escape_all_non_ascii is set. Returns last if there is none.
+
+    template <class CharT>
+    const CharT* find_char_to_escape_scalar(const CharT* first, const CharT* last,
+                                            bool escape_all_non_ascii, bool escape_solidus)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        while (first < last)
+        {
+            uchar_type c = static_cast<uchar_type>(*first);
+            if (c < 0x20 || c == '\"' || c == '\\' || c == 0x7f || (escape_solidus && c == '/') || (escape_all_non_ascii && c >= 0x80))
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    // When escape_solidus is not set, the solidus comparison repeats the quotation mark one
+    inline
+    const char* find_char_to_escape_sse2(const char* first, const char* last,
+                                         bool escape_all_non_ascii, bool escape_solidus)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1f);
+        const __m128i del = _mm_set1_epi8(0x7f);
+        const __m128i solidus = _mm_set1_epi8(escape_solidus ? '/' : '\"');
+        const uint32_t non_ascii = escape_all_non_ascii ? 0xFFFFu : 0;
+
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, control), control),
+                                                        _mm_or_si128(_mm_cmpeq_epi8(v, del), _mm_cmpeq_epi8(v, solidus))));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special)) | 
+                            (static_cast<uint32_t>(_mm_movemask_epi8(v)) & non_ascii);
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+        return find_char_to_escape_scalar(first, last, escape_all_non_ascii, escape_solidus);
+    }
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    JSONCONS_TARGET_AVX2 inline
+    const char* find_char_to_escape_avx2(const char* first, const char* last,
+                                         bool escape_all_non_ascii, bool escape_solidus)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1f);
+        const __m256i del = _mm256_set1_epi8(0x7f);
+        const __m256i solidus = _mm256_set1_epi8(escape_solidus ? '/' : '\"');
+        const uint32_t non_ascii = escape_all_non_ascii ? 0xFFFFFFFFu : 0;
+
+        while (last - first >= 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                              _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control),
+                                                              _mm256_or_si256(_mm256_cmpeq_epi8(v, del), _mm256_cmpeq_epi8(v, solidus))));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special)) | 
+                            (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & non_ascii);
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+        return find_char_to_escape_sse2(first, last, escape_all_non_ascii, escape_solidus);
+    }
+#endif
+
+    template <class CharT>
+    typename std::enable_if<!std::is_same<CharT,char>::value,const CharT*>::type
+    find_char_to_escape(const CharT* first, const CharT* last,
+                        bool escape_all_non_ascii, bool escape_solidus)
+    {
+        return find_char_to_escape_scalar(first, last, escape_all_non_ascii, escape_solidus);
+    }
+
+    template <class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value,const CharT*>::type
+    find_char_to_escape(const CharT* first, const CharT* last,
+                        bool escape_all_non_ascii, bool escape_solidus)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_supports_avx2())
+        {
+            return find_char_to_escape_avx2(first, last, escape_all_non_ascii, escape_solidus);
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        return find_char_to_escape_sse2(first, last, escape_all_non_ascii, escape_solidus);
+    #else
+        return find_char_to_escape_scalar(first, last, escape_all_non_ascii, escape_solidus);
+    #endif
+    }
+
+    // find_non_ascii
+    //
+    // Returns a pointer to the first character in [first,last) with the high bit set,
+    // or last if there is none.
+
+    template <class CharT>
+    const CharT* find_non_ascii_scalar(const CharT* first, const CharT* last)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        while (first < last && static_cast<uchar_type>(*first) < 0x80)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    inline
+    const char* find_non_ascii_sse2(const char* first, const char* last)
+    {
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+        return find_non_ascii_scalar(first, last);
+    }
+#endif
+
+#if defined(JSONCONS_HAS_SSE2)
+    // 16 and 32 bit code units, a unit is ASCII if all of its bits above the low seven are zero
+    template <class CharT>
+    const CharT* find_non_ascii_wide_sse2(const CharT* first, const CharT* last)
+    {
+        const std::size_t units_per_block = 16 / sizeof(CharT);
+        const __m128i high_bits = sizeof(CharT) == 2 ? _mm_set1_epi16(static_cast<short>(~0x7F)) : _mm_set1_epi32(~0x7F);
+        const __m128i zero = _mm_setzero_si128();
+
+        while (static_cast<std::size_t>(last - first) >= units_per_block)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, high_bits), zero))) ^ 0xFFFFu;
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask) / sizeof(CharT);
+            }
+            first += units_per_block;
+        }
+        return find_non_ascii_scalar(first, last);
+    }
+#endif
+
+    template <class CharT>
+    typename std::enable_if<!std::is_same<CharT,char>::value && !(std::is_integral<CharT>::value && (sizeof(CharT) == 2 || sizeof(CharT) == 4)),const CharT*>::type
+    find_non_ascii(const CharT* first, const CharT* last)
+    {
+        return find_non_ascii_scalar(first, last);
+    }
+
+    template <class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value,const CharT*>::type
+    find_non_ascii(const CharT* first, const CharT* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        return find_non_ascii_sse2(first, last);
+    #else
+        return find_non_ascii_scalar(first, last);
+    #endif
+    }
+
+    template <class CharT>
+    typename std::enable_if<std::is_integral<CharT>::value && (sizeof(CharT) == 2 || sizeof(CharT) == 4),const CharT*>::type
+    find_non_ascii(const CharT* first, const CharT* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        return find_non_ascii_wide_sse2(first, last);
+    #else
+        return find_non_ascii_scalar(first, last);
+    #endif
+    }
+
+    // copy_ascii
+    //
+    // Copies the ASCII characters [first,last) to out, widening bytes to 16 or 32 bit code
+    // units, or narrowing 16 or 32 bit code units to bytes. The characters must all be 
+    // ASCII, as found by find_non_ascii.
+
+    template <class CharT,class OutT>
+    void copy_ascii_scalar(const CharT* first, const CharT* last, OutT* out)
+    {
+        while (first != last)
+        {
+            *out++ = static_cast<OutT>(*first++);
+        }
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    template <class CharT,class OutT>
+    void widen_ascii_sse2(const CharT* first, const CharT* last, OutT* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i lo = _mm_unpacklo_epi8(v, zero);
+            __m128i hi = _mm_unpackhi_epi8(v, zero);
+            if (sizeof(OutT) == 2)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), hi);
+            }
+            else
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+            first += 16;
+            out += 16;
+        }
+        copy_ascii_scalar(first, last, out);
+    }
+
+    // The saturating packs leave ASCII values unchanged
+    template <class CharT,class OutT>
+    void narrow_ascii_sse2(const CharT* first, const CharT* last, OutT* out)
+    {
+        while (last - first >= 16)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(first);
+            __m128i v;
+            if (sizeof(CharT) == 2)
+            {
+                v = _mm_packus_epi16(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+            }
+            else
+            {
+                __m128i lo = _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+                __m128i hi = _mm_packs_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3));
+                v = _mm_packus_epi16(lo, hi);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+            first += 16;
+            out += 16;
+        }
+        copy_ascii_scalar(first, last, out);
+    }
+#endif
+
+    template <class CharT,class OutT>
+    typename std::enable_if<std::is_integral<CharT>::value && std::is_integral<OutT>::value &&
+                            sizeof(CharT) == 1 && (sizeof(OutT) == 2 || sizeof(OutT) == 4)>::type
+    copy_ascii(const CharT* first, const CharT* last, OutT* out)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        widen_ascii_sse2(first, last, out);
+    #else
+        copy_ascii_scalar(first, last, out);
+    #endif
+    }
+
+    template <class CharT,class OutT>
+    typename std::enable_if<std::is_integral<CharT>::value && std::is_integral<OutT>::value &&
+                            (sizeof(CharT) == 2 || sizeof(CharT) == 4) && sizeof(OutT) == 1>::type
+    copy_ascii(const CharT* first, const CharT* last, OutT* out)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        narrow_ascii_sse2(first, last, out);
+    #else
+        copy_ascii_scalar(first, last, out);
+    #endif
+    }
+
+    // skip_valid_utf8
+    //
+    // Returns a pointer p to the start of a character in [first,last] such that [first,p)
+    // is valid UTF-8. The caller validates [p,last) with a scalar validator, which also
+    // finds the position and kind of the first error, if there is one. For valid input,
+    // p is within 35 bytes of last when AVX2 is available, and is first otherwise.
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    // The lookup algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than One 
+    // Instruction Per Byte" (2021). Each byte is classified together with the byte before
+    // it by three 16 entry tables, indexed by the high and low nibbles of the previous
+    // byte and the high nibble of the byte, and the and of the three lookups is non zero
+    // for an invalid pair. The third and fourth bytes of a sequence are checked against
+    // the lead bytes two and three positions back.
+    JSONCONS_TARGET_AVX2 inline
+    const char* skip_valid_utf8_avx2(const char* first, const char* last)
+    {
+        const uint8_t too_short = 1 << 0;      // 11______ 0_______, 11______ 11______
+        const uint8_t too_long = 1 << 1;       // 0_______ 10______
+        const uint8_t overlong_3 = 1 << 2;     // 11100000 100_____
+        const uint8_t too_large = 1 << 3;      // 11110100 1001____ and above
+        const uint8_t surrogate = 1 << 4;      // 11101101 101_____
+        const uint8_t overlong_2 = 1 << 5;     // 1100000_ 10______
+        const uint8_t too_large_1000 = 1 << 6; // 11110101 1000____ and above
+        const uint8_t overlong_4 = 1 << 6;     // 11110000 1000____
+        const uint8_t two_conts = 1 << 7;      // 10______ 10______
+        const uint8_t carry = too_short | too_long | two_conts;
+
+        static const uint8_t byte_1_high_table[16] = {
+            // 0_______ ________
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+            // 10______ ________
+            two_conts, two_conts, two_conts, two_conts,
+            // 1100____ ________
+            too_short | overlong_2,
+            // 1101____ ________
+            too_short,
+            // 1110____ ________
+            too_short | overlong_3 | surrogate,
+            // 1111____ ________
+            too_short | too_large | too_large_1000 | overlong_4
+        };
+        static const uint8_t byte_1_low_table[16] = {
+            // ____0000 ________
+            carry | overlong_3 | overlong_2 | overlong_4,
+            // ____0001 ________
+            carry | overlong_2,
+            // ____001_ ________
+            carry, 
+            carry,
+            // ____0100 ________
+            carry | too_large,
+            // ____0101 ________ to ____1100 ________
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            // ____1101 ________
+            carry | too_large | too_large_1000 | surrogate,
+            // ____111_ ________
+            carry | too_large | too_large_1000, 
+            carry | too_large | too_large_1000
+        };
+        static const uint8_t byte_2_high_table[16] = {
+            // ________ 0_______
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+            // ________ 1000____
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            // ________ 1001____
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            // ________ 101_____
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            // ________ 11______
+            too_short, too_short, too_short, too_short
+        };
+        // A lead byte in one of the last three positions that is greater than these needs
+        // bytes from the next block
+        static const uint8_t max_value_table[32] = {
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+        };
+
+        const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_high_table)));
+        const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_low_table)));
+        const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_2_high_table)));
+        const __m256i max_value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(max_value_table));
+        const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+        const __m256i third_byte = _mm256_set1_epi8(0xe0 - 0x80);
+        const __m256i fourth_byte = _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80));
+        const __m256i high_bit = _mm256_set1_epi8(static_cast<char>(0x80));
+
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_incomplete = _mm256_setzero_si256();
+        const char* boundary = first;
+
+        while (last - first >= 32)
+        {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i error;
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                // An unfinished sequence at the end of the previous block is an error
+                error = prev_incomplete;
+                prev_incomplete = _mm256_setzero_si256();
+            }
+            else
+            {
+                // The input shifted by one, two and three bytes, with the end of the previous block shifted in
+                __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+                __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+                __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+                __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+                __m256i special = _mm256_and_si256(
+                    _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble_mask)),
+                                     _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble_mask))),
+                    _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask)));
+                __m256i must_be_continuation = _mm256_and_si256(
+                    _mm256_or_si256(_mm256_subs_epu8(prev2, third_byte), _mm256_subs_epu8(prev3, fourth_byte)), high_bit);
+
+                error = _mm256_xor_si256(must_be_continuation, special);
+                prev_incomplete = _mm256_subs_epu8(input, max_value);
+            }
+            if (!_mm256_testz_si256(error, error))
+            {
+                return boundary;
+            }
+            prev_input = input;
+            first += 32;
+
+            boundary = first;
+            if (!_mm256_testz_si256(prev_incomplete, prev_incomplete))
+            {
+                // Back up to the lead byte of the unfinished sequence
+                for (int i = 1; i <= 3; ++i)
+                {
+                    if (static_cast<uint8_t>(first[-i]) >= 0xc0)
+                    {
+                        boundary = first - i;
+                        break;
+                    }
+                }
+            }
+        }
+        return boundary;
+    }
+#endif
+
+    template <class CharT>
+    typename std::enable_if<!std::is_same<CharT,char>::value,const CharT*>::type
+    skip_valid_utf8(const CharT* first, const CharT*)
+    {
+        return first;
+    }
+
+    template <class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value,const CharT*>::type
+    skip_valid_utf8(const CharT* first, const CharT* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_supports_avx2())
+        {
+            return skip_valid_utf8_avx2(first, last);
+        }
+    #endif
+        (void)last;
+        return first;
+    }
+
+    // json_block_masks
+    //
+    // Bit i of each mask describes the i-th byte of a 64 byte block
+
+    struct json_block_masks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t structural; // { } [ ] : ,
+        uint64_t whitespace; // space, tab, line feed, carriage return
+    };
+
+    inline
+    void classify_json_block_scalar(const char* p, json_block_masks& masks)
+    {
+        masks = json_block_masks{0,0,0,0};
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            uint64_t bit = uint64_t(1) << i;
+            switch (p[i])
+            {
+                case '\"':
+                    masks.quote |= bit;
+                    break;
+                case '\\':
+                    masks.backslash |= bit;
+                    break;
+                case '{':case '}':case '[':case ']':case ':':case ',':
+                    masks.structural |= bit;
+                    break;
+                case ' ':case '\t':case '\n':case '\r':
+                    masks.whitespace |= bit;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    inline
+    void classify_json_block_sse2(const char* p, json_block_masks& masks)
+    {
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lower = _mm_set1_epi8(0x20);
+        const __m128i lbrace = _mm_set1_epi8('{'); // also '[' after or-ing 0x20
+        const __m128i rbrace = _mm_set1_epi8('}'); // also ']' after or-ing 0x20
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        masks = json_block_masks{0,0,0,0};
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16*i));
+            __m128i v_lower = _mm_or_si128(v, lower);
+            __m128i structural = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v_lower, lbrace), _mm_cmpeq_epi8(v_lower, rbrace)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+            __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+            unsigned shift = 16*i;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << shift;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << shift;
+            masks.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(structural))) << shift;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(whitespace))) << shift;
+        }
+    }
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    JSONCONS_TARGET_AVX2 inline
+    void classify_json_block_avx2(const char* p, json_block_masks& masks)
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i lower = _mm256_set1_epi8(0x20);
+        const __m256i lbrace = _mm256_set1_epi8('{');
+        const __m256i rbrace = _mm256_set1_epi8('}');
+        const __m256i colon = _mm256_set1_epi8(':');
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+
+        masks = json_block_masks{0,0,0,0};
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32*i));
+            __m256i v_lower = _mm256_or_si256(v, lower);
+            __m256i structural = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v_lower, lbrace), _mm256_cmpeq_epi8(v_lower, rbrace)),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+            __m256i whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+            unsigned shift = 32*i;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)))) << shift;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)))) << shift;
+            masks.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(structural))) << shift;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << shift;
+        }
+    }
+#endif
+
+    inline
+    void classify_json_block(const char* p, json_block_masks& masks)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_supports_avx2())
+        {
+            classify_json_block_avx2(p, masks);
+            return;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        classify_json_block_sse2(p, masks);
+    #else
+        classify_json_block_scalar(p, masks);
+    #endif
+    }
+
+
+    // byte_swap_copy
+    //
+    // Copies count elements of width bytes (1, 2, 4 or 8) from first to out, reversing 
+    // the byte order of each element. first and out may be the same buffer.
+
+    template <class T>
+    void byte_swap_copy_scalar(const uint8_t* first, std::size_t count, uint8_t* out)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T val;
+            std::memcpy(&val, first + i*sizeof(T), sizeof(T));
+            val = binary::byte_swap<T>(val);
+            std::memcpy(out + i*sizeof(T), &val, sizeof(T));
+        }
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+    // Returns the number of bytes swapped, a multiple of 16
+    template <std::size_t Width>
+    std::size_t byte_swap_copy_sse2(const uint8_t* first, std::size_t length, uint8_t* out)
+    {
+        std::size_t n = length - length % 16;
+        for (std::size_t i = 0; i < n; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            // Swap the bytes of each 16 bit word, then reverse the words of each element
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            if (Width == 4)
+            {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xb1), 0xb1);
+            }
+            else if (Width == 8)
+            {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1b), 0x1b);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        }
+        return n;
+    }
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    // Returns the number of bytes swapped, a multiple of 32
+    template <std::size_t Width>
+    JSONCONS_TARGET_AVX2 
+    std::size_t byte_swap_copy_avx2(const uint8_t* first, std::size_t length, uint8_t* out)
+    {
+        // Byte j of each 128 bit lane comes from byte (j/Width)*Width + Width-1-j%Width
+        const __m256i shuffle = Width == 2 ? _mm256_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14,
+                                                              1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)
+                              : Width == 4 ? _mm256_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12,
+                                                              3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12)
+                                           : _mm256_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+                                                              7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+        std::size_t n = length - length % 32;
+        for (std::size_t i = 0; i < n; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v, shuffle));
+        }
+        return n;
+    }
+#endif
+
+    template <class T>
+    void byte_swap_copy(const uint8_t* first, std::size_t count, uint8_t* out)
+    {
+        std::size_t length = count*sizeof(T);
+        std::size_t done = 0;
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_supports_avx2())
+        {
+            done = byte_swap_copy_avx2<sizeof(T)>(first, length, out);
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        done += byte_swap_copy_sse2<sizeof(T)>(first + done, length - done, out + done);
+    #endif
+        byte_swap_copy_scalar<T>(first + done, (length - done)/sizeof(T), out + done);
+    }
+
+    inline
+    void byte_swap_copy(const uint8_t* first, std::size_t count, std::size_t width, uint8_t* out)
+    {
+        switch (width)
+        {
+            case 2:
+                byte_swap_copy<uint16_t>(first, count, out);
+                break;
+            case 4:
+                byte_swap_copy<uint32_t>(first, count, out);
+                break;
+            case 8:
+                byte_swap_copy<uint64_t>(first, count, out);
+                break;
+            default:
+                if (count > 0 && first != out)
+                {
+                    std::memmove(out, first, count*width);
+                }
+                break;
+        }
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -16,7 +16,8 @@
 #include <stdio.h> // snprintf
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
-#include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/schubfach.hpp>
+#include <jsoncons/detail/decimal_digits.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 #include <jsoncons/more_type_traits.hpp>
 
@@ -30,9 +31,53 @@ namespace detail {
     }
 
     // from_integer
+    //
+    // Integers of up to 64 bits are formatted two digits at a time into a local buffer,
+    // front to back, and appended to result in one step if it has an append member 
+    // function, as the sinks and strings do.
+
+    template <class Result>
+    typename std::enable_if<type_traits::has_append<Result>::value>::type
+    append_chars(const typename Result::value_type* s, std::size_t length, Result& result)
+    {
+        result.append(s, length);
+    }
+
+    template <class Result>
+    typename std::enable_if<!type_traits::has_append<Result>::value>::type
+    append_chars(const typename Result::value_type* s, std::size_t length, Result& result)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            result.push_back(s[i]);
+        }
+    }
 
     template<class Integer,class Result>
-    typename std::enable_if<type_traits::is_integer<Integer>::value,std::size_t>::type
+    typename std::enable_if<type_traits::is_integer<Integer>::value && sizeof(Integer) <= sizeof(uint64_t),std::size_t>::type
+    from_integer(Integer value, Result& result)
+    {
+        using char_type = typename Result::value_type;
+
+        char_type buf[24];
+        char_type* p = buf;
+
+        uint64_t magnitude = static_cast<uint64_t>(value);
+        if (value < 0)
+        {
+            *p++ = '-';
+            magnitude = 0 - magnitude;
+        }
+        std::size_t count = count_decimal_digits(magnitude);
+        write_decimal_digits(magnitude, p, count);
+        p += count;
+
+        append_chars(buf, static_cast<std::size_t>(p - buf), result);
+        return static_cast<std::size_t>(p - buf);
+    }
+
+    template<class Integer,class Result>
+    typename std::enable_if<type_traits::is_integer<Integer>::value && (sizeof(Integer) > sizeof(uint64_t)),std::size_t>::type
     from_integer(Integer value, Result& result)
     {
         using char_type = typename Result::value_type;
@@ -284,7 +329,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_scientific(double val, char decimal_point, Result& result)
+    bool dtoa_scientific(double val, char decimal_point, Result& result, std::false_type)
     {
         if (val == 0)
         {
@@ -316,6 +361,33 @@ namespace detail {
         return true;
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char, Result& result, std::true_type)
+    {
+        if (v == 0)
+        {
+            result.push_back('0');
+            result.push_back('.');
+            result.push_back('0');
+            return true;
+        }
+
+        int length = 0;
+        int k;
+
+        char buffer[100];
+
+        double u = std::signbit(v) ? -v : v;
+        jsoncons::detail::schubfach(u, buffer, &length, &k);
+        if (std::signbit(v))
+        {
+            result.push_back('-');
+        }
+        // Bounds that leave no room for positional notation
+        jsoncons::detail::prettify_string(buffer, length, k, 0, 0, result);
+        return true;
+    }
+
     template<class Result>
     bool dtoa_general(double val, char decimal_point, Result& result, std::false_type)
     {
@@ -350,7 +422,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_general(double v, char decimal_point, Result& result, std::true_type)
+    bool dtoa_general(double v, char, Result& result, std::true_type)
     {
         if (v == 0)
         {
@@ -366,21 +438,15 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
-        {
-            if (std::signbit(v))
-            {
-                result.push_back('-');
-            }
-            // min exp: -4 is consistent with sprintf
-            // max exp: std::numeric_limits<double>::max_digits10
-            jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
-            return true;
-        }
-        else
+        jsoncons::detail::schubfach(u, buffer, &length, &k);
+        if (std::signbit(v))
         {
-            return dtoa_general(v, decimal_point, result, std::false_type());
+            result.push_back('-');
         }
+        // min exp: -4 is consistent with sprintf
+        // max exp: std::numeric_limits<double>::max_digits10
+        jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
+        return true;
     }
 
     template<class Result>
@@ -417,7 +483,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_fixed(double v, char decimal_point, Result& result, std::true_type)
+    bool dtoa_fixed(double v, char, Result& result, std::true_type)
     {
         if (v == 0)
         {
@@ -433,19 +499,13 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
-        {
-            if (std::signbit(v))
-            {
-                result.push_back('-');
-            }
-            jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
-            return true;
-        }
-        else
+        jsoncons::detail::schubfach(u, buffer, &length, &k);
+        if (std::signbit(v))
         {
-            return dtoa_fixed(v, decimal_point, result, std::false_type());
+            result.push_back('-');
         }
+        jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
+        return true;
     }
 
     template<class Result>
@@ -460,6 +520,12 @@ namespace detail {
         return dtoa_general(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char decimal_point, Result& result)
+    {
+        return dtoa_scientific(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
+    }
+
     class write_double
     {
     private:
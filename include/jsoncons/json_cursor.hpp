@@ -267,6 +267,40 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        if (!done() && (cursor_visitor_.event().event_type() == staj_event_type::begin_object || 
+                        cursor_visitor_.event().event_type() == staj_event_type::begin_array))
+        {
+            parser_.begin_skip();
+            while (!parser_.skip_some())
+            {
+                if (source_.eof())
+                {
+                    ec = json_errc::unexpected_eof;
+                    return;
+                }
+                auto s = source_.read_buffer(ec);
+                if (ec) return;
+                if (s.size() > 0)
+                {
+                    parser_.update(s.data(),s.size());
+                }
+            }
+        }
+        read_next(ec);
+    }
+
     void check_done()
     {
         std::error_code ec;
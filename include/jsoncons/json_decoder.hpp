@@ -55,13 +55,23 @@ private:
 
     enum class structure_type {root_t, array_t, object_t};
 
+    // An open array or object. If its length was given, its elements or members are 
+    // constructed in place in its own storage. Otherwise they are staged on item_stack_ 
+    // from first_item_, and moved into storage of exactly the right size when it ends.
+    // The container itself is at item_stack_[container_index_] if its parent is staged,
+    // and at container_ otherwise.
     struct structure_info
     {
         structure_type type_;
+        bool staged_;
+        std::size_t first_item_;
         std::size_t container_index_;
+        Json* container_;
 
-        structure_info(structure_type type, std::size_t offset) noexcept
-            : type_(type), container_index_(offset)
+        structure_info(structure_type type, bool staged, std::size_t first_item, 
+                       std::size_t container_index, Json* container) noexcept
+            : type_(type), staged_(staged), first_item_(first_item), 
+              container_index_(container_index), container_(container)
         {
         }
 
@@ -93,7 +103,7 @@ public:
     {
         item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, false, 0, 0, nullptr);
     }
 
     json_decoder(result_allocator_arg_t,
@@ -108,7 +118,7 @@ public:
     {
         item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, false, 0, 0, nullptr);
     }
 
     json_decoder(result_allocator_arg_t,
@@ -124,7 +134,7 @@ public:
     {
         item_stack_.reserve(1000);
         structure_stack_.reserve(100);
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, false, 0, 0, nullptr);
     }
 
     void reset()
@@ -132,7 +142,7 @@ public:
         is_valid_ = false;
         item_stack_.clear();
         structure_stack_.clear();
-        structure_stack_.emplace_back(structure_type::root_t, 0);
+        structure_stack_.emplace_back(structure_type::root_t, false, 0, 0, nullptr);
     }
 
     bool is_valid() const
@@ -157,57 +167,124 @@ public:
 
 private:
 
-    void visit_flush() override
+    Json& container(const structure_info& info)
     {
+        return info.container_ != nullptr ? *info.container_ : item_stack_[info.container_index_].value_;
     }
 
-    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+    // Constructs a value at the end of the innermost open array or object, or as the result
+    template <class... Args>
+    Json& emplace_value(Args&&... args)
+    {
+        const structure_info& info = structure_stack_.back();
+        if (info.staged_)
+        {
+            item_stack_.emplace_back(std::move(name_), std::forward<Args>(args)...);
+            return item_stack_.back().value_;
+        }
+        switch (info.type_)
+        {
+            case structure_type::object_t:
+                return container(info).object_value().bulk_emplace_back(std::move(name_), std::forward<Args>(args)...);
+            case structure_type::array_t:
+                return container(info).array_value().emplace_back(std::forward<Args>(args)...);
+            default:
+                result_ = Json(std::forward<Args>(args)...);
+                return result_;
+        }
+    }
+
+    // An in place container does not move while it is open, because only the innermost
+    // container grows, and a staged one is found by its position on item_stack_.
+    template <class... Args>
+    Json& begin_container(structure_type type, bool staged, Args&&... args)
     {
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
             item_stack_.clear();
             is_valid_ = false;
         }
-        item_stack_.emplace_back(std::forward<key_type>(name_), json_object_arg, tag, result_allocator_);
-        structure_stack_.emplace_back(structure_type::object_t, item_stack_.size()-1);
-        return true;
+        const bool parent_staged = structure_stack_.back().staged_;
+        Json& val = emplace_value(std::forward<Args>(args)...);
+        if (parent_staged)
+        {
+            structure_stack_.emplace_back(type, staged, item_stack_.size(), item_stack_.size() - 1, nullptr);
+        }
+        else
+        {
+            structure_stack_.emplace_back(type, staged, item_stack_.size(), 0, &val);
+        }
+        return val;
     }
 
-    bool visit_end_object(const ser_context&, std::error_code&) override
+    // The capacity to reserve for a container of the given length. The length comes 
+    // from the input and may not be trusted, so the reservation is bounded.
+    static std::size_t reserve_hint(std::size_t length)
+    {
+        return length < 1024 ? length : 1024;
+    }
+
+    // Called when a value is complete, returns false if it completes the result
+    bool end_value()
     {
-        JSONCONS_ASSERT(structure_stack_.size() > 0);
-        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
-        const size_t structure_index = structure_stack_.back().container_index_;
-        JSONCONS_ASSERT(item_stack_.size() > structure_index);
-        const size_t count = item_stack_.size() - (structure_index + 1);
-        auto first = item_stack_.begin() + (structure_index+1);
-        auto last = first + count;
-        item_stack_[structure_index].value_.object_value().insert(
-            std::make_move_iterator(first),
-            std::make_move_iterator(last),
-            [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));}
-        );
-        item_stack_.erase(item_stack_.begin()+structure_index+1, item_stack_.end());
-        structure_stack_.pop_back();
         if (structure_stack_.back().type_ == structure_type::root_t)
         {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
             is_valid_ = true;
             return false;
         }
         return true;
     }
 
-    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    void visit_flush() override
     {
-        if (structure_stack_.back().type_ == structure_type::root_t)
+    }
+
+    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        begin_container(structure_type::object_t, true, json_object_arg, tag, result_allocator_);
+        return true;
+    }
+
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        Json& val = begin_container(structure_type::object_t, false, json_object_arg, tag, result_allocator_);
+        val.object_value().reserve(reserve_hint(length));
+        return true;
+    }
+
+    bool visit_end_object(const ser_context&, std::error_code&) override
+    {
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
+        const structure_info& info = structure_stack_.back();
+        auto& obj = container(info).object_value();
+        if (info.staged_)
         {
-            item_stack_.clear();
-            is_valid_ = false;
+            JSONCONS_ASSERT(item_stack_.size() >= info.first_item_);
+            auto first = item_stack_.begin() + info.first_item_;
+            obj.insert(std::make_move_iterator(first),
+                       std::make_move_iterator(item_stack_.end()),
+                       [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));});
+            item_stack_.erase(first, item_stack_.end());
+        }
+        else
+        {
+            obj.end_bulk_insert();
         }
-        item_stack_.emplace_back(std::forward<key_type>(name_), json_array_arg, tag, result_allocator_);
-        structure_stack_.emplace_back(structure_type::array_t, item_stack_.size()-1);
+        structure_stack_.pop_back();
+        return end_value();
+    }
+
+    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        begin_container(structure_type::array_t, true, json_array_arg, tag, result_allocator_);
+        return true;
+    }
+
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        Json& val = begin_container(structure_type::array_t, false, json_array_arg, tag, result_allocator_);
+        val.array_value().reserve(reserve_hint(length));
         return true;
     }
 
@@ -215,35 +292,21 @@ private:
     {
         JSONCONS_ASSERT(structure_stack_.size() > 1);
         JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
-        const size_t container_index = structure_stack_.back().container_index_;
-        JSONCONS_ASSERT(item_stack_.size() > container_index);
-
-        auto& container = item_stack_[container_index].value_;
-
-        const size_t size = item_stack_.size() - (container_index + 1);
-        //std::cout << "size on item stack: " << size << "\n";
-
-        if (size > 0)
+        const structure_info& info = structure_stack_.back();
+        if (info.staged_)
         {
-            container.reserve(size);
-            auto first = item_stack_.begin() + (container_index+1);
-            auto last = first + size;
-            for (auto it = first; it != last; ++it)
+            JSONCONS_ASSERT(item_stack_.size() >= info.first_item_);
+            auto& arr = container(info).array_value();
+            auto first = item_stack_.begin() + info.first_item_;
+            arr.reserve(item_stack_.size() - info.first_item_);
+            for (auto it = first; it != item_stack_.end(); ++it)
             {
-                container.push_back(std::move(it->value_));
+                arr.push_back(std::move(it->value_));
             }
             item_stack_.erase(first, item_stack_.end());
         }
-
         structure_stack_.pop_back();
-        if (structure_stack_.back().type_ == structure_type::root_t)
-        {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            return false;
-        }
-        return true;
+        return end_value();
     }
 
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
@@ -254,18 +317,8 @@ private:
 
     bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), sv, tag, result_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(sv, tag, result_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(sv, tag, result_allocator_);
+        return end_value();
     }
 
     bool visit_byte_string(const byte_string_view& b, 
@@ -273,18 +326,8 @@ private:
                            const ser_context&,
                            std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), byte_string_arg, b, tag, result_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(byte_string_arg, b, tag, result_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(byte_string_arg, b, tag, result_allocator_);
+        return end_value();
     }
 
     bool visit_byte_string(const byte_string_view& b, 
@@ -292,18 +335,8 @@ private:
                            const ser_context&,
                            std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), byte_string_arg, b, ext_tag, result_allocator_);
-                break;
-            case structure_type::root_t:
-                result_ = Json(byte_string_arg, b, ext_tag, result_allocator_);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(byte_string_arg, b, ext_tag, result_allocator_);
+        return end_value();
     }
 
     bool visit_int64(int64_t value, 
@@ -311,18 +344,8 @@ private:
                         const ser_context&,
                         std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value,tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value();
     }
 
     bool visit_uint64(uint64_t value, 
@@ -330,18 +353,8 @@ private:
                          const ser_context&,
                          std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value,tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value();
     }
 
     bool visit_half(uint16_t value, 
@@ -349,18 +362,8 @@ private:
                        const ser_context&,
                        std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), half_arg, value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(half_arg, value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(half_arg, value, tag);
+        return end_value();
     }
 
     bool visit_double(double value, 
@@ -368,50 +371,20 @@ private:
                          const ser_context&,
                          std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value();
     }
 
     bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(value, tag);
+        return end_value();
     }
 
     bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), null_type(), tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(null_type(), tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        emplace_value(null_type(), tag);
+        return end_value();
     }
 };
 
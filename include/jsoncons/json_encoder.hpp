@@ -23,6 +23,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/simd.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -49,6 +50,18 @@ namespace detail {
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            // Append the run of characters that need no escaping in one step
+            const CharT* run_end = jsoncons::detail::find_char_to_escape(it, end, escape_all_non_ascii, escape_solidus);
+            if (run_end != it)
+            {
+                sink.append(it, static_cast<std::size_t>(run_end - it));
+                count += static_cast<std::size_t>(run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
             CharT c = *it;
             switch (c)
             {
@@ -94,7 +107,8 @@ namespace detail {
                         sink.push_back('/');
                         count += 2;
                     }
-                    else if (is_control_character(c) || escape_all_non_ascii)
+                    else if (is_control_character(c) || 
+                             (escape_all_non_ascii && static_cast<typename std::make_unsigned<CharT>::type>(c) >= 0x80))
                     {
                         // convert to codepoint
                         uint32_t cp;
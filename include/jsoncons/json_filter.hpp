@@ -581,6 +581,7 @@ public:
     using typename From::string_view_type;
     using supertype::destination;
 private:
+    std::basic_string<typename To::char_type> buffer_;
 
     // noncopyable
     json_visitor_adaptor(const json_visitor_adaptor&) = delete;
@@ -601,13 +602,13 @@ private:
                  const ser_context& context,
                  std::error_code& ec) override
     {
-        std::basic_string<typename To::char_type> target;
-        auto result = unicode_traits::convert(name.data(), name.size(), target, unicode_traits::conv_flags::strict);
+        buffer_.clear();
+        auto result = unicode_traits::convert(name.data(), name.size(), buffer_, unicode_traits::conv_flags::strict);
         if (result.ec != unicode_traits::conv_errc())
         {
             ec = result.ec;
         }
-        return destination().key(target, context, ec);
+        return destination().key(buffer_, context, ec);
     }
 
     bool visit_string(const string_view_type& value,
@@ -615,14 +616,14 @@ private:
                       const ser_context& context,
                       std::error_code& ec) override
     {
-        std::basic_string<typename To::char_type> target;
+        buffer_.clear();
         auto result = unicode_traits::convert(value.data(), value.size(),
-                                              target,unicode_traits::conv_flags::strict);
+                                              buffer_,unicode_traits::conv_flags::strict);
         if (result.ec != unicode_traits::conv_errc())
         {
             JSONCONS_THROW(ser_error(result.ec));
         }
-        return destination().string_value(target, tag, context, ec);
+        return destination().string_value(buffer_, tag, context, ec);
     }
 };
 
@@ -0,0 +1,529 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <istream>
+#include <algorithm> // std::find, std::count, std::min
+#include <system_error>
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <utility> // std::move
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+    // basic_json_lines_reader
+    // Reads JSON Lines (newline delimited JSON) text, one JSON value per line.
+    // The input is split into newline aligned chunks that are parsed on a pool of
+    // worker threads, each with its own basic_json_parser and json_decoder.
+    // Values are always passed to the callback on the calling thread.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class basic_json_lines_reader
+    {
+    public:
+        using value_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+    private:
+        static constexpr std::size_t default_chunk_size = 1024*1024;
+
+        struct line_chunk
+        {
+            std::size_t index;
+            std::size_t first_line;
+            const char_type* data;
+            std::size_t length;
+            std::basic_string<char_type> storage;
+        };
+
+        struct line_record
+        {
+            std::size_t line;
+            Json value;
+        };
+
+        struct chunk_result
+        {
+            std::size_t index;
+            std::vector<line_record> records;
+            std::error_code ec;
+            std::size_t line;
+            std::size_t column;
+            std::exception_ptr eptr;
+
+            explicit chunk_result(std::size_t index)
+                : index(index), line(0), column(0)
+            {
+            }
+        };
+
+        // Reports positions in the whole text rather than the line
+        class line_context : public ser_context
+        {
+            const ser_context& context_;
+            std::size_t line_;
+        public:
+            line_context(const ser_context& context, std::size_t line)
+                : context_(context), line_(line)
+            {
+            }
+
+            std::size_t line() const override
+            {
+                return line_;
+            }
+
+            std::size_t column() const override
+            {
+                return context_.column();
+            }
+        };
+
+        class worker_state
+        {
+            basic_json_parser<char_type,TempAllocator> parser_;
+            json_decoder<Json,TempAllocator> decoder_;
+            std::size_t current_line_;
+        public:
+            worker_state(const basic_json_decode_options<char_type>& options,
+                         std::function<bool(json_errc,const ser_context&)> err_handler,
+                         const TempAllocator& alloc)
+                : parser_(options,
+                          [this,err_handler](json_errc ec, const ser_context& context) -> bool
+                          {
+                              return err_handler(ec, line_context(context, current_line_));
+                          },
+                          alloc),
+                  decoder_(alloc),
+                  current_line_(0)
+            {
+            }
+
+            void parse(const line_chunk& chunk, chunk_result& result)
+            {
+                const char_type* p = chunk.data;
+                const char_type* last = chunk.data + chunk.length;
+                current_line_ = chunk.first_line;
+                while (p < last)
+                {
+                    const char_type* nl = std::find(p, last, '\n');
+                    const char_type* end = nl;
+                    if (end > p && *(end-1) == '\r')
+                    {
+                        --end;
+                    }
+                    if (!is_blank(p, end))
+                    {
+                        std::error_code ec;
+                        parser_.reset();
+                        decoder_.reset();
+                        parser_.update(p, static_cast<std::size_t>(end - p));
+                        parser_.finish_parse(decoder_, ec);
+                        if (!ec)
+                        {
+                            parser_.check_done(ec);
+                        }
+                        if (!ec && !decoder_.is_valid())
+                        {
+                            ec = json_errc::unexpected_eof;
+                        }
+                        if (ec)
+                        {
+                            result.ec = ec;
+                            result.line = current_line_;
+                            result.column = parser_.column();
+                            return;
+                        }
+                        result.records.push_back(line_record{current_line_, decoder_.get_result()});
+                    }
+                    p = nl == last ? last : nl + 1;
+                    ++current_line_;
+                }
+            }
+
+        private:
+            static bool is_blank(const char_type* first, const char_type* last)
+            {
+                for (const char_type* p = first; p < last; ++p)
+                {
+                    if (*p != ' ' && *p != '\t' && *p != '\r')
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        string_view_type input_;
+        std::basic_istream<char_type>* is_;
+        basic_json_decode_options<char_type> options_;
+        std::function<bool(json_errc,const ser_context&)> err_handler_;
+        TempAllocator alloc_;
+        std::size_t num_threads_;
+        std::size_t chunk_size_;
+        bool preserve_order_;
+
+        std::size_t position_;
+        std::size_t next_line_;
+        std::size_t next_index_;
+        std::basic_string<char_type> carry_;
+        std::size_t line_;
+        std::size_t column_;
+
+        // Shared with the workers
+        std::mutex mutex_;
+        std::condition_variable work_available_;
+        std::condition_variable result_available_;
+        std::deque<line_chunk> work_;
+        std::deque<chunk_result> results_;
+        bool stopping_;
+
+        // noncopyable and nonmoveable
+        basic_json_lines_reader(const basic_json_lines_reader&) = delete;
+        basic_json_lines_reader& operator=(const basic_json_lines_reader&) = delete;
+
+    public:
+        explicit basic_json_lines_reader(string_view_type input,
+                                         const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                         std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+                                         const TempAllocator& alloc = TempAllocator())
+            : input_(input), is_(nullptr), options_(options), err_handler_(err_handler), alloc_(alloc),
+              num_threads_(std::thread::hardware_concurrency()), chunk_size_(default_chunk_size), preserve_order_(true),
+              position_(0), next_line_(1), next_index_(0), line_(0), column_(0), stopping_(false)
+        {
+        }
+
+        explicit basic_json_lines_reader(std::basic_istream<char_type>& is,
+                                         const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                         std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+                                         const TempAllocator& alloc = TempAllocator())
+            : is_(std::addressof(is)), options_(options), err_handler_(err_handler), alloc_(alloc),
+              num_threads_(std::thread::hardware_concurrency()), chunk_size_(default_chunk_size), preserve_order_(true),
+              position_(0), next_line_(1), next_index_(0), line_(0), column_(0), stopping_(false)
+        {
+        }
+
+        // The number of worker threads, 0 or 1 parses on the calling thread.
+        // The default is std::thread::hardware_concurrency()
+        basic_json_lines_reader& num_threads(std::size_t value)
+        {
+            num_threads_ = value;
+            return *this;
+        }
+
+        // The approximate size of the chunks handed to the workers, in characters
+        basic_json_lines_reader& chunk_size(std::size_t value)
+        {
+            chunk_size_ = value > 0 ? value : 1;
+            return *this;
+        }
+
+        // If true, values are passed to the callback in input order, otherwise
+        // each chunk's values are passed as soon as the chunk is parsed
+        basic_json_lines_reader& preserve_order(bool value)
+        {
+            preserve_order_ = value;
+            return *this;
+        }
+
+        // The line of the record that failed to parse
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+        // Calls f(Json&& value, std::size_t line) for each non blank line, returns the number of values read
+        template <class F>
+        std::size_t read(F f)
+        {
+            std::error_code ec;
+            std::size_t count = read(f, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+            return count;
+        }
+
+        template <class F>
+        std::size_t read(F f, std::error_code& ec)
+        {
+            if (num_threads_ <= 1)
+            {
+                return read_sequential(f, ec);
+            }
+
+            std::vector<std::thread> workers;
+            thread_guard guard(*this, workers);
+            for (std::size_t i = 0; i < num_threads_; ++i)
+            {
+                workers.emplace_back([this](){run_worker();});
+            }
+
+            // At most this many chunks are parsed but not yet passed on
+            const std::size_t max_in_flight = 2 * num_threads_;
+            std::size_t in_flight = 0;
+            std::size_t next_to_deliver = 0;
+            std::map<std::size_t,chunk_result> pending;
+            std::size_t count = 0;
+            bool more_input = true;
+
+            while (true)
+            {
+                while (more_input && in_flight < max_in_flight)
+                {
+                    line_chunk chunk;
+                    more_input = next_chunk(chunk);
+                    if (more_input)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            work_.push_back(std::move(chunk));
+                        }
+                        work_available_.notify_one();
+                        ++in_flight;
+                    }
+                }
+                if (in_flight == 0)
+                {
+                    break;
+                }
+
+                std::deque<chunk_result> ready;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    result_available_.wait(lock, [this](){return !results_.empty();});
+                    ready.swap(results_);
+                }
+                for (auto& result : ready)
+                {
+                    if (preserve_order_)
+                    {
+                        pending.emplace(result.index, std::move(result));
+                    }
+                    else
+                    {
+                        --in_flight;
+                        if (!deliver(result, f, count, ec))
+                        {
+                            return count;
+                        }
+                    }
+                }
+                if (preserve_order_)
+                {
+                    auto it = pending.find(next_to_deliver);
+                    while (it != pending.end())
+                    {
+                        --in_flight;
+                        ++next_to_deliver;
+                        if (!deliver(it->second, f, count, ec))
+                        {
+                            return count;
+                        }
+                        pending.erase(it);
+                        it = pending.find(next_to_deliver);
+                    }
+                }
+            }
+            return count;
+        }
+
+    private:
+
+        // Stops and joins the workers, also when the callback throws
+        class thread_guard
+        {
+            basic_json_lines_reader& reader_;
+            std::vector<std::thread>& workers_;
+        public:
+            thread_guard(basic_json_lines_reader& reader, std::vector<std::thread>& workers)
+                : reader_(reader), workers_(workers)
+            {
+                reader_.stopping_ = false;
+            }
+
+            thread_guard(const thread_guard&) = delete;
+            thread_guard& operator=(const thread_guard&) = delete;
+
+            ~thread_guard()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(reader_.mutex_);
+                    reader_.stopping_ = true;
+                    reader_.work_.clear();
+                }
+                reader_.work_available_.notify_all();
+                for (auto& worker : workers_)
+                {
+                    worker.join();
+                }
+                reader_.results_.clear();
+            }
+        };
+
+        void run_worker()
+        {
+            worker_state state(options_, err_handler_, alloc_);
+            while (true)
+            {
+                line_chunk chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    work_available_.wait(lock, [this](){return stopping_ || !work_.empty();});
+                    if (stopping_)
+                    {
+                        return;
+                    }
+                    chunk = std::move(work_.front());
+                    work_.pop_front();
+                }
+                chunk_result result(chunk.index);
+                JSONCONS_TRY
+                {
+                    state.parse(chunk, result);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    result.eptr = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    results_.push_back(std::move(result));
+                }
+                result_available_.notify_one();
+            }
+        }
+
+        template <class F>
+        std::size_t read_sequential(F f, std::error_code& ec)
+        {
+            worker_state state(options_, err_handler_, alloc_);
+            std::size_t count = 0;
+            line_chunk chunk;
+            while (next_chunk(chunk))
+            {
+                chunk_result result(chunk.index);
+                state.parse(chunk, result);
+                if (!deliver(result, f, count, ec))
+                {
+                    break;
+                }
+            }
+            return count;
+        }
+
+        template <class F>
+        bool deliver(chunk_result& result, F& f, std::size_t& count, std::error_code& ec)
+        {
+            if (result.eptr)
+            {
+                std::rethrow_exception(result.eptr);
+            }
+            for (auto& record : result.records)
+            {
+                f(std::move(record.value), record.line);
+                ++count;
+            }
+            if (result.ec)
+            {
+                ec = result.ec;
+                line_ = result.line;
+                column_ = result.column;
+                return false;
+            }
+            return true;
+        }
+
+        // Takes the next newline aligned chunk of input, returns false at the end
+        bool next_chunk(line_chunk& chunk)
+        {
+            chunk.index = next_index_;
+            chunk.first_line = next_line_;
+            if (is_ == nullptr)
+            {
+                if (position_ >= input_.size())
+                {
+                    return false;
+                }
+                const char_type* first = input_.data() + position_;
+                const char_type* last = input_.data() + input_.size();
+                const char_type* end = first + (std::min)(chunk_size_, input_.size() - position_);
+                end = std::find(end - 1, last, '\n');
+                if (end != last)
+                {
+                    ++end;
+                }
+                chunk.data = first;
+                chunk.length = static_cast<std::size_t>(end - first);
+                position_ += chunk.length;
+            }
+            else
+            {
+                chunk.storage.clear();
+                chunk.storage.swap(carry_);
+                std::size_t newline = chunk.storage.rfind('\n');
+                while (newline == std::basic_string<char_type>::npos && *is_)
+                {
+                    std::size_t offset = chunk.storage.size();
+                    chunk.storage.resize(offset + chunk_size_);
+                    is_->read(&chunk.storage[offset], static_cast<std::streamsize>(chunk_size_));
+                    chunk.storage.resize(offset + static_cast<std::size_t>(is_->gcount()));
+                    newline = chunk.storage.find('\n', offset);
+                    if (newline != std::basic_string<char_type>::npos)
+                    {
+                        newline = chunk.storage.rfind('\n');
+                    }
+                }
+                if (chunk.storage.empty())
+                {
+                    return false;
+                }
+                if (newline != std::basic_string<char_type>::npos && newline + 1 < chunk.storage.size())
+                {
+                    carry_.assign(chunk.storage, newline + 1, std::basic_string<char_type>::npos);
+                    chunk.storage.resize(newline + 1);
+                }
+                chunk.data = chunk.storage.data();
+                chunk.length = chunk.storage.size();
+            }
+            next_line_ += static_cast<std::size_t>(std::count(chunk.data, chunk.data + chunk.length, '\n'));
+            ++next_index_;
+            return true;
+        }
+    };
+
+    template <class Json,class TempAllocator>
+    constexpr std::size_t basic_json_lines_reader<Json,TempAllocator>::default_chunk_size;
+
+    using json_lines_reader = basic_json_lines_reader<json>;
+    using wjson_lines_reader = basic_json_lines_reader<wjson>;
+    using ojson_lines_reader = basic_json_lines_reader<ojson>;
+    using wojson_lines_reader = basic_json_lines_reader<wojson>;
+
+} // namespace jsoncons
+
+#endif
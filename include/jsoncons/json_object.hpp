@@ -12,6 +12,7 @@
 #include <tuple>
 #include <exception>
 #include <cstring>
+#include <cstdint> // uint32_t, uint64_t
 #include <algorithm> // std::sort, std::stable_sort, std::lower_bound, std::unique
 #include <utility>
 #include <initializer_list>
@@ -494,6 +495,22 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            end_bulk_insert();
+        }
+
+        // Appends a member without sorting or checking for a duplicate name, and returns 
+        // its value. The object must not be otherwise accessed until end_bulk_insert is called.
+        template <class... Args>
+        Json& bulk_emplace_back(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Sorts the members appended by bulk_emplace_back. Members with the same name
+        // as an earlier member are dropped.
+        void end_bulk_insert()
+        {
             std::stable_sort(members_.begin(),members_.end(),
                              [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
             auto it = std::unique(members_.begin(), members_.end(),
@@ -1296,7 +1313,22 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            end_bulk_insert();
+        }
+
+        // Appends a member without indexing or checking for a duplicate name, and returns 
+        // its value. The object must not be otherwise accessed until end_bulk_insert is called.
+        template <class... Args>
+        Json& bulk_emplace_back(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
 
+        // Indexes the members appended by bulk_emplace_back. Members with the same name
+        // as an earlier member are dropped.
+        void end_bulk_insert()
+        {
             build_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
@@ -1767,6 +1799,917 @@ namespace jsoncons {
         }
     };
 
+    // Preserve order, with an open addressing hash index
+    //
+    // Objects with fewer than index_threshold members are searched linearly. From
+    // index_threshold members on, index_ is a linear probing table whose capacity is a
+    // power of two with a load factor of at most 3/4. An occupied slot holds the upper
+    // 32 bits of the key's hash in its upper half and the member's position plus one in its
+    // lower half, 0 marks an empty slot. The stored hash bits give the home slot of an entry,
+    // so the table can be grown and entries deleted without hashing keys again.
+    //
+    // Appending a member is amortized O(1). Inserting or erasing a member before the end 
+    // changes the positions of the members that follow it, and so rewrites the affected 
+    // slots in one pass over the table, which is O(capacity), as it is O(n) for 
+    // order_preserving_json_object.
+    template <class KeyT,class Json,template<typename,typename> class SequenceContainer = std::vector>
+    class hash_indexed_json_object : public allocator_holder<typename Json::allocator_type>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using char_type = typename Json::char_type;
+        using key_type = KeyT;
+        using string_view_type = typename Json::string_view_type;
+        using key_value_type = key_value<KeyT,Json>;
+    private:
+        using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
+        using key_value_container_type = SequenceContainer<key_value_type,key_value_allocator_type>;
+        typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t> index_allocator_type;
+        using index_container_type = SequenceContainer<uint64_t,index_allocator_type>;
+
+        static constexpr std::size_t index_threshold = 8;
+        static constexpr uint64_t position_mask = 0xffffffff;
+
+        key_value_container_type members_;
+        index_container_type index_;
+    public:
+        using iterator = typename key_value_container_type::iterator;
+        using const_iterator = typename key_value_container_type::const_iterator;
+
+        using allocator_holder<allocator_type>::get_allocator;
+
+        hash_indexed_json_object()
+        {
+        }
+        hash_indexed_json_object(const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+        }
+
+        hash_indexed_json_object(const hash_indexed_json_object& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(val.members_),
+              index_(val.index_)
+        {
+        }
+
+        hash_indexed_json_object(hash_indexed_json_object&& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(std::move(val.members_)),
+              index_(std::move(val.index_))
+        {
+        }
+
+        hash_indexed_json_object(const hash_indexed_json_object& val, const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(val.members_,key_value_allocator_type(alloc)),
+              index_(val.index_,index_allocator_type(alloc))
+        {
+        }
+
+        hash_indexed_json_object(hash_indexed_json_object&& val,const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(std::move(val.members_),key_value_allocator_type(alloc)),
+              index_(std::move(val.index_),index_allocator_type(alloc))
+        {
+        }
+
+        template<class InputIt>
+        hash_indexed_json_object(InputIt first, InputIt last)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        template<class InputIt>
+        hash_indexed_json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        hash_indexed_json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
+                    const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+            reserve(init.size());
+            for (auto& item : init)
+            {
+                insert_or_assign(item.first, item.second);
+            }
+        }
+
+        ~hash_indexed_json_object() noexcept
+        {
+            flatten_and_destroy();
+        }
+
+        hash_indexed_json_object& operator=(hash_indexed_json_object&& val)
+        {
+            val.swap(*this);
+            return *this;
+        }
+
+        hash_indexed_json_object& operator=(const hash_indexed_json_object& val)
+        {
+            allocator_holder<allocator_type>::operator=(val.get_allocator());
+            members_ = val.members_;
+            index_ = val.index_;
+            return *this;
+        }
+
+        void swap(hash_indexed_json_object& val) noexcept
+        {
+            members_.swap(val.members_);
+            index_.swap(val.index_);
+        }
+
+        bool empty() const
+        {
+            return members_.empty();
+        }
+
+        iterator begin()
+        {
+            return members_.begin();
+        }
+
+        iterator end()
+        {
+            return members_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return members_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return members_.end();
+        }
+
+        std::size_t size() const {return members_.size();}
+
+        std::size_t capacity() const {return members_.capacity();}
+
+        void clear() 
+        {
+            members_.clear();
+            index_.clear();
+        }
+
+        void shrink_to_fit() 
+        {
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                members_[i].shrink_to_fit();
+            }
+            members_.shrink_to_fit();
+            if (!index_.empty() && index_capacity_for(members_.size()) < index_.size())
+            {
+                rehash(index_capacity_for(members_.size()));
+            }
+        }
+
+        void reserve(std::size_t n) 
+        {
+            members_.reserve(n);
+            reserve_index(n);
+        }
+
+        Json& at(std::size_t i) 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        const Json& at(std::size_t i) const 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            return members_.begin() + find_position(name, hash_key(name));
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            return members_.begin() + find_position(name, hash_key(name));
+        }
+
+        iterator erase(const_iterator pos) 
+        {
+            if (pos != members_.end())
+            {
+                std::size_t pos1 = pos - members_.begin();
+                std::size_t pos2 = pos1 + 1;
+
+                erase_index_entries(pos1, pos2);
+    #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
+                iterator it = members_.begin() + (pos - members_.begin());
+                return members_.erase(it);
+    #else
+                return members_.erase(pos);
+    #endif
+            }
+            else
+            {
+                return members_.end();
+            }
+        }
+
+        iterator erase(const_iterator first, const_iterator last) 
+        {
+            std::size_t pos1 = first == members_.end() ? members_.size() : first - members_.begin();
+            std::size_t pos2 = last == members_.end() ? members_.size() : last - members_.begin();
+
+            if (pos1 < members_.size() && pos2 <= members_.size())
+            {
+                erase_index_entries(pos1,pos2);
+
+    #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
+                iterator it1 = members_.begin() + (first - members_.begin());
+                iterator it2 = members_.begin() + (last - members_.begin());
+                return members_.erase(it1,it2);
+    #else
+                return members_.erase(first,last);
+    #endif
+            }
+            else
+            {
+                return members_.end();
+            }
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            auto pos = find(name);
+            if (pos != members_.end())
+            {
+                std::size_t pos1 = pos - members_.begin();
+                std::size_t pos2 = pos1 + 1;
+
+                erase_index_entries(pos1, pos2);
+    #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
+                iterator it = members_.begin() + (pos - members_.begin());
+                members_.erase(it);
+    #else
+                members_.erase(pos);
+    #endif
+            }
+        }
+
+        // Members with the same name as an earlier member are dropped
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+            reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                key_value_type kv(convert(*s));
+                uint32_t h = hash_key(kv.key());
+                if (find_position(kv.key(), h) == members_.size())
+                {
+                    members_.emplace_back(std::move(kv));
+                    insert_index_entry(members_.size()-1, h);
+                }
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+            reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                members_.emplace_back(convert(*s));
+                insert_index_entry(members_.size()-1, hash_key(members_.back().key()));
+            }
+        }
+
+        // Appends a member without indexing or checking for a duplicate name, and returns 
+        // its value. The object must not be otherwise accessed until end_bulk_insert is called.
+        template <class... Args>
+        Json& bulk_emplace_back(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Indexes the members appended by bulk_emplace_back. Members with the same name
+        // as an earlier member are dropped.
+        void end_bulk_insert()
+        {
+            JSONCONS_ASSERT(members_.size() < position_mask);
+            // Reuses the table allocated by an earlier reserve
+            index_.assign(members_.size() < index_threshold ? 0 : index_capacity_for(members_.size()), uint64_t(0));
+
+            // Only the members kept so far, at [0,count), are in the index
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                uint32_t h = hash_key(members_[i].key());
+                bool duplicate = false;
+                if (index_.empty())
+                {
+                    for (std::size_t k = 0; k < count && !duplicate; ++k)
+                    {
+                        duplicate = members_[k].key() == members_[i].key();
+                    }
+                }
+                else
+                {
+                    const std::size_t mask = index_.size() - 1;
+                    for (std::size_t k = h & mask; index_[k] != 0 && !duplicate; k = (k + 1) & mask)
+                    {
+                        duplicate = slot_hash(index_[k]) == h && members_[slot_position(index_[k])].key() == members_[i].key();
+                    }
+                }
+                if (!duplicate)
+                {
+                    if (count != i)
+                    {
+                        members_[count] = std::move(members_[i]);
+                    }
+                    if (!index_.empty())
+                    {
+                        place(make_slot(h, count));
+                    }
+                    ++count;
+                }
+            }
+            members_.erase(members_.begin() + count, members_.end());
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            uint32_t h = hash_key(name);
+            std::size_t pos = find_position(name, h);
+            if (pos == members_.size())
+            {
+                reserve_index(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
+                insert_index_entry(pos, h);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value)));
+                return std::make_pair(it,false);
+            }
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<!type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            uint32_t h = hash_key(name);
+            std::size_t pos = find_position(name, h);
+            if (pos == members_.size())
+            {
+                reserve_index(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
+                                      std::forward<T>(value),get_allocator());
+                insert_index_entry(pos, h);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value),get_allocator()));
+                return std::make_pair(it,false);
+            }
+        }
+
+        template <class A=allocator_type, class T>
+        typename std::enable_if<type_traits::is_stateless<A>::value,iterator>::type 
+        insert_or_assign(iterator hint, const string_view_type& key, T&& value)
+        {
+            if (hint == members_.end())
+            {
+                auto result = insert_or_assign(key, std::forward<T>(value));
+                return result.first;
+            }
+            else
+            {
+                uint32_t h = hash_key(key);
+                std::size_t found = find_position(key, h);
+                if (found == members_.size())
+                {
+                    std::size_t pos = hint - members_.begin();
+                    reserve_index(members_.size() + 1);
+                    auto it = members_.emplace(members_.begin() + pos, key_type(key.begin(), key.end()), std::forward<T>(value));
+                    insert_index_entry(pos, h);
+                    return it;
+                }
+                else
+                {
+                    auto it = members_.begin() + found;
+                    it->value(Json(std::forward<T>(value)));
+                    return it;
+                }
+            }
+        }
+
+        template <class A=allocator_type, class T>
+        typename std::enable_if<!type_traits::is_stateless<A>::value,iterator>::type 
+        insert_or_assign(iterator hint, const string_view_type& key, T&& value)
+        {
+            if (hint == members_.end())
+            {
+                auto result = insert_or_assign(key, std::forward<T>(value));
+                return result.first;
+            }
+            else
+            {
+                uint32_t h = hash_key(key);
+                std::size_t found = find_position(key, h);
+                if (found == members_.size())
+                {
+                    std::size_t pos = hint - members_.begin();
+                    reserve_index(members_.size() + 1);
+                    auto it = members_.emplace(members_.begin() + pos, 
+                                               key_type(key.begin(),key.end(),get_allocator()), 
+                                               std::forward<T>(value),get_allocator());
+                    insert_index_entry(pos, h);
+                    return it;
+                }
+                else
+                {
+                    auto it = members_.begin() + found;
+                    it->value(Json(std::forward<T>(value),get_allocator()));
+                    return it;
+                }
+            }
+        }
+
+        // merge
+
+        void merge(const hash_indexed_json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace((*it).key(),(*it).value());
+            }
+        }
+
+        void merge(hash_indexed_json_object&& source)
+        {
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                auto pos = find((*it).key());
+                if (pos == members_.end() )
+                {
+                    try_emplace((*it).key(),std::move((*it).value()));
+                }
+            }
+        }
+
+        void merge(iterator hint, const hash_indexed_json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(hint, (*it).key(),(*it).value());
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        void merge(iterator hint, hash_indexed_json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                hint = try_emplace(hint, (*it).key(), std::move((*it).value()));
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const hash_indexed_json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign((*it).key(),(*it).value());
+            }
+        }
+
+        void merge_or_update(hash_indexed_json_object&& source)
+        {
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                auto pos = find((*it).key());
+                if (pos == members_.end() )
+                {
+                    insert_or_assign((*it).key(),std::move((*it).value()));
+                }
+                else
+                {
+                    pos->value(std::move((*it).value()));
+                }
+            }
+        }
+
+        void merge_or_update(iterator hint, const hash_indexed_json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(hint, (*it).key(),(*it).value());
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        void merge_or_update(iterator hint, hash_indexed_json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                hint = insert_or_assign(hint, (*it).key(), std::move((*it).value()));
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        // try_emplace
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            uint32_t h = hash_key(name);
+            std::size_t pos = find_position(name, h);
+            if (pos == members_.size())
+            {
+                reserve_index(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
+                insert_index_entry(pos, h);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<!type_traits::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& key, Args&&... args)
+        {
+            uint32_t h = hash_key(key);
+            std::size_t pos = find_position(key, h);
+            if (pos == members_.size())
+            {
+                reserve_index(members_.size() + 1);
+                members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
+                                      std::forward<Args>(args)...);
+                insert_index_entry(pos, h);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+     
+        template <class A=allocator_type, class ... Args>
+        typename std::enable_if<type_traits::is_stateless<A>::value,iterator>::type
+        try_emplace(iterator hint, const string_view_type& key, Args&&... args)
+        {
+            if (hint == members_.end())
+            {
+                auto result = try_emplace(key, std::forward<Args>(args)...);
+                return result.first;
+            }
+            else
+            {
+                uint32_t h = hash_key(key);
+                std::size_t found = find_position(key, h);
+                if (found == members_.size())
+                {
+                    std::size_t pos = hint - members_.begin();
+                    reserve_index(members_.size() + 1);
+                    auto it = members_.emplace(members_.begin() + pos, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
+                    insert_index_entry(pos, h);
+                    return it;
+                }
+                else
+                {
+                    return members_.begin() + found;
+                }
+            }
+        }
+
+        template <class A=allocator_type, class ... Args>
+        typename std::enable_if<!type_traits::is_stateless<A>::value,iterator>::type
+        try_emplace(iterator hint, const string_view_type& key, Args&&... args)
+        {
+            if (hint == members_.end())
+            {
+                auto result = try_emplace(key, std::forward<Args>(args)...);
+                return result.first;
+            }
+            else
+            {
+                uint32_t h = hash_key(key);
+                std::size_t found = find_position(key, h);
+                if (found == members_.size())
+                {
+                    std::size_t pos = hint - members_.begin();
+                    reserve_index(members_.size() + 1);
+                    auto it = members_.emplace(members_.begin() + pos, 
+                                               key_type(key.begin(),key.end(), get_allocator()), 
+                                               std::forward<Args>(args)...);
+                    insert_index_entry(pos, h);
+                    return it;
+                }
+                else
+                {
+                    return members_.begin() + found;
+                }
+            }
+        }
+
+        bool operator==(const hash_indexed_json_object& rhs) const
+        {
+            return members_ == rhs.members_;
+        }
+     
+        bool operator<(const hash_indexed_json_object& rhs) const
+        {
+            return members_ < rhs.members_;
+        }
+    private:
+
+        void flatten_and_destroy() noexcept
+        {
+            if (!members_.empty())
+            {
+                json_array<Json> temp(get_allocator());
+
+                for (auto&& kv : members_)
+                {
+                    if (kv.value().size() > 0)
+                    {
+                        temp.emplace_back(std::move(kv.value()));
+                    }
+                }
+            }
+        }
+
+        // FNV-1a over the code units, followed by the murmur3 finalizer; 
+        // returns the upper 32 bits
+        static uint32_t hash_key(const string_view_type& key) noexcept
+        {
+            uint64_t h = 14695981039346656037ULL;
+            for (auto c : key)
+            {
+                h ^= static_cast<uint64_t>(static_cast<typename std::make_unsigned<char_type>::type>(c));
+                h *= 1099511628211ULL;
+            }
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return static_cast<uint32_t>(h >> 32);
+        }
+
+        static std::size_t index_capacity_for(std::size_t n)
+        {
+            std::size_t capacity = 16;
+            while (capacity * 3 < n * 4)
+            {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        static std::size_t slot_position(uint64_t slot)
+        {
+            return static_cast<std::size_t>(slot & position_mask) - 1;
+        }
+
+        static uint32_t slot_hash(uint64_t slot)
+        {
+            return static_cast<uint32_t>(slot >> 32);
+        }
+
+        static uint64_t make_slot(uint32_t h, std::size_t pos)
+        {
+            return (static_cast<uint64_t>(h) << 32) | static_cast<uint64_t>(pos + 1);
+        }
+
+        // Returns the position of the member named key, or members_.size() if there is none
+        std::size_t find_position(const string_view_type& key, uint32_t h) const noexcept
+        {
+            if (index_.empty())
+            {
+                for (std::size_t i = 0; i < members_.size(); ++i)
+                {
+                    if (members_[i].key() == key)
+                    {
+                        return i;
+                    }
+                }
+                return members_.size();
+            }
+            const std::size_t mask = index_.size() - 1;
+            for (std::size_t i = h & mask; index_[i] != 0; i = (i + 1) & mask)
+            {
+                if (slot_hash(index_[i]) == h && members_[slot_position(index_[i])].key() == key)
+                {
+                    return slot_position(index_[i]);
+                }
+            }
+            return members_.size();
+        }
+
+        // Makes room in the index for n members, building it when n reaches index_threshold
+        void reserve_index(std::size_t n)
+        {
+            if (n < index_threshold)
+            {
+                return;
+            }
+            JSONCONS_ASSERT(n < position_mask);
+            if (index_.empty())
+            {
+                index_.resize(index_capacity_for(n));
+                for (std::size_t i = 0; i < members_.size(); ++i)
+                {
+                    place(make_slot(hash_key(members_[i].key()), i));
+                }
+            }
+            else if (index_.size() * 3 < n * 4)
+            {
+                rehash(index_capacity_for(n));
+            }
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            index_container_type old(capacity, uint64_t(0), index_allocator_type(get_allocator()));
+            old.swap(index_);
+            for (auto slot : old)
+            {
+                if (slot != 0)
+                {
+                    place(slot);
+                }
+            }
+        }
+
+        void place(uint64_t slot)
+        {
+            const std::size_t mask = index_.size() - 1;
+            std::size_t i = slot_hash(slot) & mask;
+            while (index_[i] != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            index_[i] = slot;
+        }
+
+        // Records a member just inserted at pos. Room must have been reserved.
+        void insert_index_entry(std::size_t pos, uint32_t h)
+        {
+            if (index_.empty())
+            {
+                reserve_index(members_.size());
+                return;
+            }
+            if (pos + 1 != members_.size())
+            {
+                for (auto& slot : index_)
+                {
+                    if (slot != 0 && slot_position(slot) >= pos)
+                    {
+                        ++slot;
+                    }
+                }
+            }
+            place(make_slot(h, pos));
+        }
+
+        // Removes the entries of the members in [pos1,pos2), before they are erased
+        void erase_index_entries(std::size_t pos1, std::size_t pos2)
+        {
+            JSONCONS_ASSERT(pos1 <= pos2);
+            JSONCONS_ASSERT(pos2 <= members_.size());
+
+            if (index_.empty())
+            {
+                return;
+            }
+            const std::size_t mask = index_.size() - 1;
+            for (std::size_t pos = pos1; pos < pos2; ++pos)
+            {
+                std::size_t i = hash_key(members_[pos].key()) & mask;
+                while (index_[i] != 0 && slot_position(index_[i]) != pos)
+                {
+                    i = (i + 1) & mask;
+                }
+                JSONCONS_ASSERT(index_[i] != 0);
+
+                // backward shift deletion
+                std::size_t j = i;
+                while (true)
+                {
+                    j = (j + 1) & mask;
+                    if (index_[j] == 0)
+                    {
+                        break;
+                    }
+                    std::size_t home = slot_hash(index_[j]) & mask;
+                    bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+                    if (!stays)
+                    {
+                        index_[i] = index_[j];
+                        i = j;
+                    }
+                }
+                index_[i] = 0;
+            }
+            const std::size_t offset = pos2 - pos1;
+            if (offset > 0 && pos2 < members_.size())
+            {
+                for (auto& slot : index_)
+                {
+                    if (slot != 0 && slot_position(slot) >= pos2)
+                    {
+                        slot -= offset;
+                    }
+                }
+            }
+        }
+    };
+
 } // namespace jsoncons
 
 #endif
@@ -325,9 +325,11 @@ public:
     using typename super_type::string_type;
 private:
     bool lossless_number_:1;
+    bool structural_index_:1;
 public:
     basic_json_decode_options()
-        : lossless_number_(false)
+        : lossless_number_(false),
+          structural_index_(false)
     {
     }
 
@@ -335,7 +337,8 @@ public:
 
     basic_json_decode_options(basic_json_decode_options&& other)
         : super_type(std::forward<basic_json_decode_options>(other)),
-                     lossless_number_(other.lossless_number_)
+                     lossless_number_(other.lossless_number_),
+                     structural_index_(other.structural_index_)
     {
     }
 
@@ -346,6 +349,11 @@ public:
         return lossless_number_;
     }
 
+    bool structural_index() const 
+    {
+        return structural_index_;
+    }
+
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use lossless_number()")
     bool dec_to_str() const 
@@ -544,6 +552,7 @@ public:
     using basic_json_decode_options<CharT>::neginf_to_num;
 
     using basic_json_decode_options<CharT>::lossless_number;
+    using basic_json_decode_options<CharT>::structural_index;
 
     using basic_json_encode_options<CharT>::byte_string_format;
     using basic_json_encode_options<CharT>::bigint_format;
@@ -725,6 +734,12 @@ public:
         return *this;
     }
 
+    basic_json_options& structural_index(bool value) 
+    {
+        this->structural_index_ = value;
+        return *this;
+    }
+
     basic_json_options& line_length_limit(std::size_t value)
     {
         this->line_length_limit_ = value;
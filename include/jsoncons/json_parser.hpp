@@ -21,6 +21,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -31,7 +32,187 @@ namespace jsoncons {
 
 namespace detail {
 
-}
+    // json_skip_scanner
+    //
+    // Finds the end of an object or array whose opening bracket has already been consumed,
+    // counting brackets outside of strings without parsing or validating the content. 
+    // The input may be scanned in pieces, the state carried from one piece to the next
+    // is kept between calls. char input is classified 64 characters at a time.
+
+    template <class CharT>
+    class json_skip_scanner
+    {
+    public:
+        using char_type = CharT;
+        static constexpr std::size_t block_size = 64;
+    private:
+        std::size_t depth_;
+        bool in_string_;
+        bool escaped_;
+        bool prev_cr_;
+        const char_type* line_start_;
+    public:
+        json_skip_scanner()
+            : depth_(0), in_string_(false), escaped_(false), prev_cr_(false), line_start_(nullptr)
+        {
+        }
+
+        void reset()
+        {
+            depth_ = 1;
+            in_string_ = false;
+            escaped_ = false;
+            prev_cr_ = false;
+        }
+
+        // Scans [first,last), returns the position past the closing bracket, 
+        // or last if the closing bracket has not been reached.
+        const char_type* scan(const char_type* first, const char_type* last)
+        {
+            const char_type* p = scan_blocks(first, last);
+            if (depth_ == 0)
+            {
+                return p;
+            }
+            for (; p != last; ++p)
+            {
+                if (in_string_)
+                {
+                    if (escaped_)
+                    {
+                        escaped_ = false;
+                    }
+                    else if (*p == '\\')
+                    {
+                        escaped_ = true;
+                    }
+                    else if (*p == '\"')
+                    {
+                        in_string_ = false;
+                    }
+                }
+                else 
+                {
+                    switch (*p)
+                    {
+                        case '\"':
+                            in_string_ = true;
+                            break;
+                        case '{':case '[':
+                            ++depth_;
+                            break;
+                        case '}':case ']':
+                            if (--depth_ == 0)
+                            {
+                                return p + 1;
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            }
+            return last;
+        }
+
+        bool done() const
+        {
+            return depth_ == 0;
+        }
+
+        // Counts the line breaks in [first,last), a carriage return followed by a 
+        // line feed is counted once. Sets line_start() to the position following
+        // the last line break, or nullptr if there are none.
+        std::size_t count_lines(const char_type* first, const char_type* last)
+        {
+            std::size_t lines = 0;
+            line_start_ = nullptr;
+            for (const char_type* p = first; p != last; ++p)
+            {
+                if (*p == '\n')
+                {
+                    if (!prev_cr_)
+                    {
+                        ++lines;
+                    }
+                    line_start_ = p + 1;
+                    prev_cr_ = false;
+                }
+                else if (*p == '\r')
+                {
+                    ++lines;
+                    line_start_ = p + 1;
+                    prev_cr_ = true;
+                }
+                else
+                {
+                    prev_cr_ = false;
+                }
+            }
+            return lines;
+        }
+
+        const char_type* line_start() const
+        {
+            return line_start_;
+        }
+
+    private:
+
+        template <class C = char_type>
+        typename std::enable_if<std::is_same<C,char>::value,const char_type*>::type
+        scan_blocks(const char_type* p, const char_type* last)
+        {
+            uint64_t prev_escaped = escaped_ ? 1 : 0;
+            uint64_t prev_in_string = in_string_ ? ~uint64_t(0) : 0;
+            for (; static_cast<std::size_t>(last - p) >= block_size; p += block_size)
+            {
+                jsoncons::detail::json_block_masks masks;
+                jsoncons::detail::classify_json_block(p, masks);
+
+                uint64_t escaped = jsoncons::detail::find_escaped(masks.backslash, prev_escaped);
+                uint64_t quote = masks.quote & ~escaped;
+                uint64_t in_string = jsoncons::detail::prefix_xor(quote) ^ prev_in_string;
+                prev_in_string = uint64_t(0) - (in_string >> 63);
+
+                uint64_t bits = masks.structural & ~in_string;
+                while (bits != 0)
+                {
+                    unsigned i = jsoncons::detail::count_trailing_zeros(bits);
+                    switch (p[i])
+                    {
+                        case '{':case '[':
+                            ++depth_;
+                            break;
+                        case '}':case ']':
+                            if (--depth_ == 0)
+                            {
+                                return p + i + 1;
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                    bits &= bits - 1;
+                }
+            }
+            escaped_ = prev_escaped != 0;
+            in_string_ = prev_in_string != 0;
+            return p;
+        }
+
+        template <class C = char_type>
+        typename std::enable_if<!std::is_same<C,char>::value,const char_type*>::type
+        scan_blocks(const char_type* p, const char_type*)
+        {
+            return p;
+        }
+    };
+
+    template <class CharT>
+    constexpr std::size_t json_skip_scanner<CharT>::block_size;
+
+} // namespace detail
 
 enum class json_parse_state : uint8_t 
 {
@@ -160,6 +341,7 @@ private:
 
     std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
     std::vector<std::pair<string_view_type,double>> string_double_map_;
+    jsoncons::detail::json_skip_scanner<char_type> skip_scanner_;
 
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
@@ -469,6 +651,45 @@ public:
         }
     }
 
+    // Prepares to skip the object or array that was begun by the last 
+    // begin_object or begin_array event
+    void begin_skip()
+    {
+        skip_scanner_.reset();
+    }
+
+    // Consumes input up to and including the closing bracket of the object or array 
+    // being skipped, without reporting events. Returns false if the input is exhausted 
+    // before the closing bracket is reached. The skipped content is not validated.
+    bool skip_some()
+    {
+        const char_type* first = input_ptr_;
+        input_ptr_ = skip_scanner_.scan(first, end_input_);
+        std::size_t lines = skip_scanner_.count_lines(first, input_ptr_);
+        if (lines > 0)
+        {
+            line_ += lines;
+            mark_position_ = position_ + (skip_scanner_.line_start() - first);
+        }
+        position_ += (input_ptr_ - first);
+        if (!skip_scanner_.done())
+        {
+            return false;
+        }
+
+        --nesting_depth_;
+        pop_state();
+        if (parent() == json_parse_state::root)
+        {
+            state_ = json_parse_state::accept;
+        }
+        else
+        {
+            state_ = json_parse_state::expect_comma_or_end;
+        }
+        return true;
+    }
+
     void reinitialize()
     {
         reset();
@@ -2174,6 +2395,7 @@ exp3:
         }
 
 string_u1:
+        input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
         while (input_ptr_ < local_input_end)
         {
             switch (*input_ptr_)
@@ -18,6 +18,7 @@
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_structural_parser.hpp>
 #include <jsoncons/source_adaptor.hpp>
 
 namespace jsoncons {
@@ -32,6 +33,7 @@ namespace jsoncons {
     private:
         basic_default_json_visitor<CharT> default_visitor_;
         basic_json_visitor<CharT>& other_visitor_;
+        std::basic_string<CharT> buffer_;
         //std::function<bool(json_errc,const ser_context&)> err_handler_;
 
         // noncopyable and nonmoveable
@@ -80,29 +82,29 @@ namespace jsoncons {
 
         bool visit_key(const string_view_type& name, const ser_context& context, std::error_code& ec) override
         {
-            std::basic_string<CharT> target;
+            buffer_.clear();
             auto result = unicode_traits::convert(
-                name.data(), name.size(), target, 
+                name.data(), name.size(), buffer_, 
                 unicode_traits::conv_flags::strict);
             if (result.ec != unicode_traits::conv_errc())
             {
                 JSONCONS_THROW(ser_error(result.ec,context.line(),context.column()));
             }
-            return other_visitor_.key(target, context, ec);
+            return other_visitor_.key(buffer_, context, ec);
         }
 
         bool visit_string(const string_view_type& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
-            std::basic_string<CharT> target;
+            buffer_.clear();
             auto result = unicode_traits::convert(
-                value.data(), value.size(), target, 
+                value.data(), value.size(), buffer_, 
                 unicode_traits::conv_flags::strict);
             if (result.ec != unicode_traits::conv_errc())
             {
                 ec = result.ec;
                 return false;
             }
-            return other_visitor_.string_value(target, tag, context, ec);
+            return other_visitor_.string_value(buffer_, tag, context, ec);
         }
 
         bool visit_int64(int64_t value, 
@@ -164,6 +166,8 @@ namespace jsoncons {
         basic_default_json_visitor<CharT> default_visitor_;
         basic_json_visitor<CharT>& visitor_;
         basic_json_parser<CharT,Allocator> parser_;
+        basic_json_structural_parser<CharT,Allocator> structural_parser_;
+        bool use_structural_index_;
 
         // Noncopyable and nonmoveable
         basic_json_reader(const basic_json_reader&) = delete;
@@ -263,7 +267,9 @@ namespace jsoncons {
                           const Allocator& alloc = Allocator())
            : source_(std::forward<Sourceable>(source)),
              visitor_(visitor),
-             parser_(options,err_handler,alloc)
+             parser_(options,err_handler,alloc),
+             structural_parser_(options,err_handler,alloc),
+             use_structural_index_(options.structural_index() && is_contiguous_source<Source>::value)
         {
         }
 
@@ -286,39 +292,106 @@ namespace jsoncons {
             read_next(ec);
             if (ec)
             {
-                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+                JSONCONS_THROW(ser_error(ec,line(),column()));
             }
         }
 
         void read_next(std::error_code& ec)
+        {
+            if (use_structural_index_)
+            {
+                read_next_(structural_parser_, ec);
+            }
+            else
+            {
+                read_next_(parser_, ec);
+            }
+        }
+
+        void check_done()
+        {
+            std::error_code ec;
+            check_done(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+        }
+
+        std::size_t line() const
+        {
+            return use_structural_index_ ? structural_parser_.line() : parser_.line();
+        }
+
+        std::size_t column() const
+        {
+            return use_structural_index_ ? structural_parser_.column() : parser_.column();
+        }
+
+        void check_done(std::error_code& ec)
+        {
+            if (use_structural_index_)
+            {
+                check_done_(structural_parser_, ec);
+            }
+            else
+            {
+                check_done_(parser_, ec);
+            }
+        }
+
+        bool eof() const
+        {
+            return (use_structural_index_ ? structural_parser_.source_exhausted() : parser_.source_exhausted()) && source_.eof();
+        }
+
+        void read()
+        {
+            read_next();
+            check_done();
+        }
+
+        void read(std::error_code& ec)
+        {
+            read_next(ec);
+            if (!ec)
+            {
+                check_done(ec);
+            }
+        }
+
+    private:
+
+        template <class Parser>
+        void read_next_(Parser& parser, std::error_code& ec)
         {
             if (source_.is_error())
             {
                 ec = json_errc::source_error;
                 return;
             }        
-            parser_.reset();
-            while (!parser_.stopped())
+            parser.reset();
+            while (!parser.stopped())
             {
-                if (parser_.source_exhausted())
+                if (parser.source_exhausted())
                 {
                     auto s = source_.read_buffer(ec);
                     if (ec) return;
                     if (s.size() > 0)
                     {
-                        parser_.update(s.data(),s.size());
+                        parser.update(s.data(),s.size());
                     }
                 }
-                bool eof = parser_.source_exhausted();
-                parser_.parse_some(visitor_, ec);
+                bool eof = parser.source_exhausted();
+                parser.parse_some(visitor_, ec);
                 if (ec) return;
                 if (eof)
                 {
-                    if (parser_.enter())
+                    if (parser.enter())
                     {
                         break;
                     }
-                    else if (!parser_.accept())
+                    else if (!parser.accept())
                     {
                         ec = json_errc::unexpected_eof;
                         return;
@@ -328,14 +401,14 @@ namespace jsoncons {
             
             while (!source_.eof())
             {
-                parser_.skip_whitespace();
-                if (parser_.source_exhausted())
+                parser.skip_whitespace();
+                if (parser.source_exhausted())
                 {
                     auto s = source_.read_buffer(ec);
                     if (ec) return;
                     if (s.size() > 0)
                     {
-                        parser_.update(s.data(),s.size());
+                        parser.update(s.data(),s.size());
                     }
                 }
                 else
@@ -345,27 +418,8 @@ namespace jsoncons {
             }
         }
 
-        void check_done()
-        {
-            std::error_code ec;
-            check_done(ec);
-            if (ec)
-            {
-                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
-            }
-        }
-
-        std::size_t line() const
-        {
-            return parser_.line();
-        }
-
-        std::size_t column() const
-        {
-            return parser_.column();
-        }
-
-        void check_done(std::error_code& ec)
+        template <class Parser>
+        void check_done_(Parser& parser, std::error_code& ec)
         {
             if (source_.is_error())
             {
@@ -374,51 +428,31 @@ namespace jsoncons {
             }   
             if (source_.eof())
             {
-                parser_.check_done(ec);
+                parser.check_done(ec);
                 if (ec) return;
             }
             else
             {
                 do
                 {
-                    if (parser_.source_exhausted())
+                    if (parser.source_exhausted())
                     {
                         auto s = source_.read_buffer(ec);
                         if (ec) return;
                         if (s.size() > 0)
                         {
-                            parser_.update(s.data(),s.size());
+                            parser.update(s.data(),s.size());
                         }
                     }
-                    if (!parser_.source_exhausted())
+                    if (!parser.source_exhausted())
                     {
-                        parser_.check_done(ec);
+                        parser.check_done(ec);
                         if (ec) return;
                     }
                 }
                 while (!eof());
             }
         }
-
-        bool eof() const
-        {
-            return parser_.source_exhausted() && source_.eof();
-        }
-
-        void read()
-        {
-            read_next();
-            check_done();
-        }
-
-        void read(std::error_code& ec)
-        {
-            read_next(ec);
-            if (!ec)
-            {
-                check_done(ec);
-            }
-        }
     };
 
     template<class CharT,class Source=jsoncons::stream_source<CharT>,class Allocator=std::allocator<char>>
@@ -0,0 +1,1145 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_STRUCTURAL_PARSER_HPP
+#define JSONCONS_JSON_STRUCTURAL_PARSER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <algorithm> // std::min
+#include <system_error>
+#include <functional> // std::function
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // json_structural_indexer
+    //
+    // Stage 1 of the structural parser. Classifies the input 64 characters at a time
+    // and appends the offsets of the structural characters, the opening quotes of strings,
+    // and the first characters of other values. The input may be indexed in pieces,
+    // the state carried from one block to the next is kept between calls.
+
+    template <class CharT>
+    class json_structural_indexer
+    {
+    public:
+        using char_type = CharT;
+        static constexpr std::size_t block_size = 64;
+    private:
+        std::size_t indexed_length_;
+        uint64_t prev_escaped_;
+        uint64_t prev_in_string_;
+        uint64_t prev_boundary_;
+    public:
+        json_structural_indexer()
+            : indexed_length_(0), prev_escaped_(0), prev_in_string_(0), prev_boundary_(1)
+        {
+        }
+
+        void reset()
+        {
+            indexed_length_ = 0;
+            prev_escaped_ = 0;
+            prev_in_string_ = 0;
+            prev_boundary_ = 1;
+        }
+
+        // The length of the input that has been indexed so far
+        std::size_t indexed_length() const
+        {
+            return indexed_length_;
+        }
+
+        // Indexes the input from indexed_length() up to chunk_end
+        template <class Vector>
+        void index(const char_type* begin_input, std::size_t chunk_end, Vector& index)
+        {
+            uint64_t prev_escaped = prev_escaped_;
+            uint64_t prev_in_string = prev_in_string_;
+            uint64_t prev_boundary = prev_boundary_;
+
+            for (std::size_t offset = indexed_length_; offset < chunk_end; offset += block_size)
+            {
+                jsoncons::detail::json_block_masks masks;
+                std::size_t n = (std::min)(block_size, chunk_end - offset);
+                classify_block(begin_input + offset, n, masks);
+
+                uint64_t escaped = jsoncons::detail::find_escaped(masks.backslash, prev_escaped);
+                uint64_t quote = masks.quote & ~escaped;
+                // Bits are set from an opening quote up to, but not including, the closing quote
+                uint64_t in_string = jsoncons::detail::prefix_xor(quote) ^ prev_in_string;
+                prev_in_string = uint64_t(0) - (in_string >> 63);
+
+                uint64_t boundary = masks.structural | masks.whitespace | quote;
+                uint64_t follows_boundary = (boundary << 1) | prev_boundary;
+                prev_boundary = boundary >> 63;
+
+                uint64_t scalar = ~boundary & ~in_string & follows_boundary;
+                uint64_t bits = (masks.structural & ~in_string) | (quote & in_string) | scalar;
+                if (n < block_size)
+                {
+                    bits &= (uint64_t(1) << n) - 1;
+                }
+                if (bits != 0)
+                {
+                    std::size_t count = index.size();
+                    index.resize(count + jsoncons::detail::popcount(bits));
+                    std::size_t* out = index.data() + count;
+                    while (bits != 0)
+                    {
+                        *out++ = offset + jsoncons::detail::count_trailing_zeros(bits);
+                        bits &= bits - 1;
+                    }
+                }
+            }
+            indexed_length_ = chunk_end;
+            prev_escaped_ = prev_escaped;
+            prev_in_string_ = prev_in_string;
+            prev_boundary_ = prev_boundary;
+        }
+
+        // True if the indexed input ends inside a string
+        bool in_string() const
+        {
+            return prev_in_string_ != 0;
+        }
+
+    private:
+        template <class C = char_type>
+        static typename std::enable_if<std::is_same<C,char>::value>::type
+        classify_block(const char_type* p, std::size_t n, jsoncons::detail::json_block_masks& masks)
+        {
+            if (n == block_size)
+            {
+                jsoncons::detail::classify_json_block(p, masks);
+            }
+            else
+            {
+                char buf[block_size];
+                std::fill(buf, buf + block_size, ' ');
+                std::copy(p, p + n, buf);
+                jsoncons::detail::classify_json_block(buf, masks);
+            }
+        }
+
+        template <class C = char_type>
+        static typename std::enable_if<!std::is_same<C,char>::value>::type
+        classify_block(const char_type* p, std::size_t n, jsoncons::detail::json_block_masks& masks)
+        {
+            masks = jsoncons::detail::json_block_masks{0,0,0,0};
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                uint64_t bit = uint64_t(1) << i;
+                switch (p[i])
+                {
+                    case '\"':
+                        masks.quote |= bit;
+                        break;
+                    case '\\':
+                        masks.backslash |= bit;
+                        break;
+                    case '{':case '}':case '[':case ']':case ':':case ',':
+                        masks.structural |= bit;
+                        break;
+                    case ' ':case '\t':case '\n':case '\r':
+                        masks.whitespace |= bit;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    };
+
+    template <class CharT>
+    constexpr std::size_t json_structural_indexer<CharT>::block_size;
+
+} // namespace detail
+
+// basic_json_structural_parser
+//
+// A two stage parser for input that is held entirely in memory. The first stage
+// classifies the input 64 characters at a time and records the offsets of the
+// structural characters, the opening quotes of strings, and the first characters
+// of other values. The second stage walks that index and produces the same
+// basic_json_visitor events as basic_json_parser. The index is built a chunk
+// at a time, as the second stage needs it, so that it stays small.
+//
+// Unlike basic_json_parser, it does not accept comments, and it does not recover
+// from errors: the error handler is notified, and parsing stops.
+
+template <class CharT, class TempAllocator = std::allocator<char>>
+class basic_json_structural_parser : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+private:
+    struct string_maps_to_double
+    {
+        string_view_type s;
+
+        bool operator()(const std::pair<string_view_type,double>& val) const
+        {
+            return val.first == s;
+        }
+    };
+
+    using temp_allocator_type = TempAllocator;
+    using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
+    using parse_state_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<json_parse_state>;
+    using offset_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::size_t>;
+
+    static constexpr std::size_t chunk_size = 16384;
+    static constexpr std::size_t initial_string_buffer_capacity_ = 1024;
+    static constexpr std::size_t default_initial_stack_capacity_ = 100;
+
+    basic_json_decode_options<char_type> options_;
+
+    std::function<bool(json_errc,const ser_context&)> err_handler_;
+    int nesting_depth_;
+    const char_type* begin_input_;
+    const char_type* end_input_;
+    std::size_t index_pos_;
+    jsoncons::detail::json_structural_indexer<char_type> indexer_;
+    std::size_t offset_;
+    mutable std::size_t line_offset_;
+    mutable std::size_t line_;
+    mutable std::size_t line_start_;
+    json_parse_state state_;
+    bool more_;
+    bool done_;
+
+    std::basic_string<char_type,std::char_traits<char_type>,char_allocator_type> string_buffer_;
+    jsoncons::detail::chars_to to_double_;
+
+    std::vector<std::size_t,offset_allocator_type> index_;
+    std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
+    std::vector<std::pair<string_view_type,double>> string_double_map_;
+
+    // Noncopyable and nonmoveable
+    basic_json_structural_parser(const basic_json_structural_parser&) = delete;
+    basic_json_structural_parser& operator=(const basic_json_structural_parser&) = delete;
+
+public:
+    basic_json_structural_parser(const TempAllocator& alloc = TempAllocator())
+        : basic_json_structural_parser(basic_json_decode_options<char_type>(), default_json_parsing(), alloc)
+    {
+    }
+
+    basic_json_structural_parser(std::function<bool(json_errc,const ser_context&)> err_handler,
+                                 const TempAllocator& alloc = TempAllocator())
+        : basic_json_structural_parser(basic_json_decode_options<char_type>(), err_handler, alloc)
+    {
+    }
+
+    basic_json_structural_parser(const basic_json_decode_options<char_type>& options,
+                                 const TempAllocator& alloc = TempAllocator())
+        : basic_json_structural_parser(options, default_json_parsing(), alloc)
+    {
+    }
+
+    basic_json_structural_parser(const basic_json_decode_options<char_type>& options,
+                                 std::function<bool(json_errc,const ser_context&)> err_handler,
+                                 const TempAllocator& alloc = TempAllocator())
+       : options_(options),
+         err_handler_(err_handler),
+         nesting_depth_(0),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         index_pos_(0),
+         offset_(0),
+         line_offset_(0),
+         line_(1),
+         line_start_(0),
+         state_(json_parse_state::start),
+         more_(true),
+         done_(false),
+         string_buffer_(alloc),
+         index_(alloc),
+         state_stack_(alloc)
+    {
+        string_buffer_.reserve(initial_string_buffer_capacity_);
+
+        state_stack_.reserve(default_initial_stack_capacity_);
+        push_state(json_parse_state::root);
+
+        if (options_.enable_str_to_nan())
+        {
+            string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
+        }
+        if (options_.enable_str_to_inf())
+        {
+            string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
+        }
+        if (options_.enable_str_to_neginf())
+        {
+            string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+        }
+    }
+
+    ~basic_json_structural_parser() noexcept
+    {
+    }
+
+    bool source_exhausted() const
+    {
+        return index_pos_ == index_.size() && indexer_.indexed_length() == static_cast<std::size_t>(end_input_ - begin_input_);
+    }
+
+    bool done() const
+    {
+        return done_;
+    }
+
+    bool enter() const
+    {
+        return state_ == json_parse_state::start;
+    }
+
+    bool accept() const
+    {
+        return state_ == json_parse_state::accept || done_;
+    }
+
+    bool stopped() const
+    {
+        return !more_;
+    }
+
+    bool finished() const
+    {
+        return !more_ && state_ != json_parse_state::accept;
+    }
+
+    json_parse_state state() const
+    {
+        return state_;
+    }
+
+    // Whitespace is never indexed, there is nothing to skip
+    void skip_whitespace()
+    {
+    }
+
+    void reinitialize()
+    {
+        reset();
+        begin_input_ = nullptr;
+        end_input_ = nullptr;
+        index_pos_ = 0;
+        indexer_.reset();
+        offset_ = 0;
+        line_offset_ = 0;
+        line_ = 1;
+        line_start_ = 0;
+        string_buffer_.clear();
+        index_.clear();
+    }
+
+    void reset()
+    {
+        state_stack_.clear();
+        push_state(json_parse_state::root);
+        state_ = json_parse_state::start;
+        more_ = true;
+        done_ = false;
+        nesting_depth_ = 0;
+    }
+
+    void restart()
+    {
+        more_ = true;
+    }
+
+    // The whole of the input must be passed in one call,
+    // and must remain valid until parsing is finished
+    void update(const string_view_type sv)
+    {
+        update(sv.data(),sv.length());
+    }
+
+    void update(const char_type* data, std::size_t length)
+    {
+        begin_input_ = data;
+        end_input_ = data + length;
+        index_pos_ = 0;
+        indexer_.reset();
+        offset_ = 0;
+        line_offset_ = 0;
+        line_ = 1;
+        line_start_ = 0;
+        index_.clear();
+    }
+
+    void parse_some(basic_json_visitor<char_type>& visitor)
+    {
+        std::error_code ec;
+        parse_some(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void parse_some(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (state_ == json_parse_state::accept)
+        {
+            visitor.flush();
+            done_ = true;
+            state_ = json_parse_state::done;
+            more_ = false;
+            return;
+        }
+        while (more_)
+        {
+            if (state_ == json_parse_state::accept)
+            {
+                visitor.flush();
+                done_ = true;
+                state_ = json_parse_state::done;
+                more_ = false;
+                break;
+            }
+            if (!next_token())
+            {
+                if (state_ == json_parse_state::start || state_ == json_parse_state::done)
+                {
+                    more_ = false;
+                }
+                else
+                {
+                    offset_ = end_input_ - begin_input_;
+                    report_error(json_errc::unexpected_eof, ec);
+                }
+                break;
+            }
+
+            offset_ = index_[index_pos_++];
+            const char_type* p = begin_input_ + offset_;
+            switch (state_)
+            {
+                case json_parse_state::start:
+                case json_parse_state::expect_value:
+                    parse_value(p, visitor, ec);
+                    break;
+                case json_parse_state::expect_value_or_end:
+                    if (*p == ']')
+                    {
+                        end_array(visitor, ec);
+                    }
+                    else
+                    {
+                        parse_value(p, visitor, ec);
+                    }
+                    break;
+                case json_parse_state::expect_member_name_or_end:
+                    switch (*p)
+                    {
+                        case '\"':
+                            parse_string(p, visitor, ec);
+                            break;
+                        case '}':
+                            end_object(visitor, ec);
+                            break;
+                        case '\'':
+                            report_error(json_errc::single_quote, ec);
+                            break;
+                        default:
+                            report_error(json_errc::expected_key, ec);
+                            break;
+                    }
+                    break;
+                case json_parse_state::expect_member_name:
+                    switch (*p)
+                    {
+                        case '\"':
+                            parse_string(p, visitor, ec);
+                            break;
+                        case '}':
+                            report_error(json_errc::extra_comma, ec);
+                            break;
+                        case '\'':
+                            report_error(json_errc::single_quote, ec);
+                            break;
+                        default:
+                            report_error(json_errc::expected_key, ec);
+                            break;
+                    }
+                    break;
+                case json_parse_state::expect_colon:
+                    if (*p == ':')
+                    {
+                        state_ = json_parse_state::expect_value;
+                    }
+                    else
+                    {
+                        report_error(json_errc::expected_colon, ec);
+                    }
+                    break;
+                case json_parse_state::expect_comma_or_end:
+                    switch (*p)
+                    {
+                        case ',':
+                            state_ = parent() == json_parse_state::object ? json_parse_state::expect_member_name : json_parse_state::expect_value;
+                            break;
+                        case '}':
+                            end_object(visitor, ec);
+                            break;
+                        case ']':
+                            end_array(visitor, ec);
+                            break;
+                        default:
+                            report_error(parent() == json_parse_state::object ? json_errc::expected_comma_or_rbrace : json_errc::expected_comma_or_rbracket, ec);
+                            break;
+                    }
+                    break;
+                default:
+                    JSONCONS_UNREACHABLE();
+            }
+            if (ec)
+            {
+                return;
+            }
+        }
+    }
+
+    void finish_parse(basic_json_visitor<char_type>& visitor)
+    {
+        std::error_code ec;
+        finish_parse(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void finish_parse(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        while (!finished())
+        {
+            parse_some(visitor, ec);
+            if (ec) return;
+        }
+    }
+
+    void check_done()
+    {
+        std::error_code ec;
+        check_done(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void check_done(std::error_code& ec)
+    {
+        if (next_token())
+        {
+            offset_ = index_[index_pos_];
+            report_error(json_errc::extra_character, ec);
+        }
+    }
+
+    std::size_t line() const override
+    {
+        advance_line();
+        return line_;
+    }
+
+    std::size_t column() const override
+    {
+        advance_line();
+        return (offset_ - line_start_) + 1;
+    }
+
+    std::size_t position() const override
+    {
+        return offset_;
+    }
+
+    std::size_t offset() const
+    {
+        return offset_;
+    }
+
+private:
+
+    // Stage 1
+
+    // Returns true if there is an unconsumed index entry, indexing more of the input if necessary
+    bool next_token()
+    {
+        const std::size_t length = end_input_ - begin_input_;
+        while (index_pos_ == index_.size())
+        {
+            if (indexer_.indexed_length() == length)
+            {
+                return false;
+            }
+            build_index();
+        }
+        return true;
+    }
+
+    void build_index()
+    {
+        index_.clear();
+        index_pos_ = 0;
+
+        const std::size_t length = end_input_ - begin_input_;
+        indexer_.index(begin_input_, (std::min)(length, indexer_.indexed_length() + chunk_size), index_);
+    }
+
+    // Stage 2
+
+    void parse_value(const char_type* p, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        switch (*p)
+        {
+            case '{':
+                begin_object(visitor, ec);
+                break;
+            case '[':
+                begin_array(visitor, ec);
+                break;
+            case '\"':
+                parse_string(p, visitor, ec);
+                break;
+            case '-':
+            case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
+                parse_number(p, visitor, ec);
+                break;
+            case 't':
+                parse_literal(p, "true", visitor, ec);
+                break;
+            case 'f':
+                parse_literal(p, "false", visitor, ec);
+                break;
+            case 'n':
+                parse_literal(p, "null", visitor, ec);
+                break;
+            case ']':
+                if (state_ == json_parse_state::start)
+                {
+                    report_error(json_errc::unexpected_rbracket, ec);
+                }
+                else
+                {
+                    report_error(parent() == json_parse_state::array ? json_errc::extra_comma : json_errc::expected_value, ec);
+                }
+                break;
+            case '}':
+                report_error(state_ == json_parse_state::start ? json_errc::unexpected_rbrace : json_errc::expected_value, ec);
+                break;
+            case '/':
+                report_error(json_errc::illegal_comment, ec);
+                break;
+            case '\'':
+                report_error(json_errc::single_quote, ec);
+                break;
+            default:
+                if (static_cast<uint32_t>(*p) < 0x20)
+                {
+                    report_error(json_errc::illegal_control_character, ec);
+                }
+                else
+                {
+                    report_error(json_errc::expected_value, ec);
+                }
+                break;
+        }
+    }
+
+    void begin_object(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+        {
+            report_error(json_errc::max_nesting_depth_exceeded, ec);
+            return;
+        }
+        push_state(json_parse_state::object);
+        state_ = json_parse_state::expect_member_name_or_end;
+        more_ = visitor.begin_object(semantic_tag::none, *this, ec);
+    }
+
+    void end_object(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (parent() != json_parse_state::object)
+        {
+            report_error(json_errc::expected_comma_or_rbracket, ec);
+            return;
+        }
+        --nesting_depth_;
+        pop_state();
+        more_ = visitor.end_object(*this, ec);
+        after_value();
+    }
+
+    void begin_array(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+        {
+            report_error(json_errc::max_nesting_depth_exceeded, ec);
+            return;
+        }
+        push_state(json_parse_state::array);
+        state_ = json_parse_state::expect_value_or_end;
+        more_ = visitor.begin_array(semantic_tag::none, *this, ec);
+    }
+
+    void end_array(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (parent() != json_parse_state::array)
+        {
+            report_error(json_errc::expected_comma_or_rbrace, ec);
+            return;
+        }
+        --nesting_depth_;
+        pop_state();
+        more_ = visitor.end_array(*this, ec);
+        after_value();
+    }
+
+    void after_value()
+    {
+        state_ = parent() == json_parse_state::root ? json_parse_state::accept : json_parse_state::expect_comma_or_end;
+    }
+
+    // Returns the end of a number or literal
+    const char_type* find_scalar_end(const char_type* p) const
+    {
+        while (p < end_input_)
+        {
+            switch (*p)
+            {
+                case ' ':case '\t':case '\n':case '\r':
+                case '{':case '}':case '[':case ']':case ':':case ',':case '\"':
+                    return p;
+                default:
+                    ++p;
+                    break;
+            }
+        }
+        return p;
+    }
+
+    void parse_literal(const char_type* p, const char* literal, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        const char_type* last = find_scalar_end(p);
+        std::size_t length = std::char_traits<char>::length(literal);
+        std::size_t i = 0;
+        for (; i < length && p + i < last && p[i] == literal[i]; ++i)
+        {
+        }
+        if (i != length || p + i != last)
+        {
+            report_error(p + i == end_input_ ? json_errc::unexpected_eof : json_errc::invalid_value, ec);
+            return;
+        }
+        switch (*p)
+        {
+            case 't':
+                more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
+                break;
+            case 'f':
+                more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
+                break;
+            default:
+                more_ = visitor.null_value(semantic_tag::none, *this, ec);
+                break;
+        }
+        after_value();
+    }
+
+    static bool is_digit(char_type c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void parse_number(const char_type* p, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        const char_type* last = find_scalar_end(p);
+        const char_type* s = p;
+        bool is_integer = true;
+
+        if (*s == '-')
+        {
+            ++s;
+        }
+        if (s < last && *s == '0')
+        {
+            ++s;
+            if (s < last && is_digit(*s))
+            {
+                offset_ = s - begin_input_;
+                report_error(json_errc::leading_zero, ec);
+                return;
+            }
+        }
+        else if (s < last && is_digit(*s))
+        {
+            while (s < last && is_digit(*s))
+            {
+                ++s;
+            }
+        }
+        else
+        {
+            report_error(s == end_input_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+            return;
+        }
+        if (s < last && *s == '.')
+        {
+            is_integer = false;
+            const char_type* digits = ++s;
+            while (s < last && is_digit(*s))
+            {
+                ++s;
+            }
+            if (s == digits)
+            {
+                report_error(s == end_input_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+                return;
+            }
+        }
+        if (s < last && (*s == 'e' || *s == 'E'))
+        {
+            is_integer = false;
+            ++s;
+            if (s < last && (*s == '+' || *s == '-'))
+            {
+                ++s;
+            }
+            const char_type* digits = s;
+            while (s < last && is_digit(*s))
+            {
+                ++s;
+            }
+            if (s == digits)
+            {
+                report_error(s == end_input_ ? json_errc::unexpected_eof : json_errc::invalid_number, ec);
+                return;
+            }
+        }
+        if (s != last)
+        {
+            report_error(json_errc::invalid_number, ec);
+            return;
+        }
+
+        const std::size_t length = last - p;
+        if (is_integer)
+        {
+            if (*p == '-')
+            {
+                int64_t val;
+                auto result = jsoncons::detail::to_integer_unchecked(p, length, val);
+                if (result)
+                {
+                    more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
+                }
+                else // Must be overflow
+                {
+                    more_ = visitor.string_value(string_view_type(p, length), semantic_tag::bigint, *this, ec);
+                }
+            }
+            else
+            {
+                uint64_t val;
+                auto result = jsoncons::detail::to_integer_unchecked(p, length, val);
+                if (result)
+                {
+                    more_ = visitor.uint64_value(val, semantic_tag::none, *this, ec);
+                }
+                else // Must be overflow
+                {
+                    more_ = visitor.string_value(string_view_type(p, length), semantic_tag::bigint, *this, ec);
+                }
+            }
+        }
+        else if (options_.lossless_number())
+        {
+            more_ = visitor.string_value(string_view_type(p, length), semantic_tag::bigdec, *this, ec);
+        }
+        else
+        {
+            JSONCONS_TRY
+            {
+                double d = to_double_(p, length);
+                more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
+            }
+            JSONCONS_CATCH(...)
+            {
+                report_error(json_errc::invalid_number, ec);
+                return;
+            }
+        }
+        after_value();
+    }
+
+    void parse_string(const char_type* p, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        const char_type* sb = p + 1;
+        const char_type* q = sb;
+        bool has_escapes = false;
+
+        string_buffer_.clear();
+        for (;;)
+        {
+            q = jsoncons::detail::find_string_special(q, end_input_);
+            if (q == end_input_)
+            {
+                offset_ = q - begin_input_;
+                report_error(json_errc::unexpected_eof, ec);
+                return;
+            }
+            if (*q == '\"')
+            {
+                break;
+            }
+            if (*q == '\\')
+            {
+                string_buffer_.append(sb, q - sb);
+                has_escapes = true;
+                q = parse_escape(q + 1, ec);
+                if (ec) return;
+                sb = q;
+            }
+            else
+            {
+                offset_ = q - begin_input_;
+                report_error((*q == '\n' || *q == '\r' || *q == '\t') ? json_errc::illegal_character_in_string : json_errc::illegal_control_character, ec);
+                return;
+            }
+        }
+
+        string_view_type sv;
+        if (has_escapes)
+        {
+            string_buffer_.append(sb, q - sb);
+            sv = string_view_type(string_buffer_.data(), string_buffer_.length());
+        }
+        else
+        {
+            sv = string_view_type(sb, q - sb);
+        }
+
+        const char_type* non_ascii = jsoncons::detail::find_non_ascii(sv.data(), sv.data() + sv.size());
+        if (non_ascii != sv.data() + sv.size())
+        {
+            auto result = unicode_traits::validate(non_ascii, (sv.data() + sv.size()) - non_ascii);
+            if (result.ec != unicode_traits::conv_errc())
+            {
+                report_error(translate_conv_errc(result.ec), ec);
+                return;
+            }
+        }
+
+        if (state_ == json_parse_state::expect_member_name_or_end || state_ == json_parse_state::expect_member_name)
+        {
+            more_ = visitor.key(sv, *this, ec);
+            state_ = json_parse_state::expect_colon;
+        }
+        else
+        {
+            auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
+            if (it != string_double_map_.end())
+            {
+                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
+            }
+            else
+            {
+                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+            }
+            after_value();
+        }
+    }
+
+    // q points to the character following the backslash, returns the character following the escape
+    const char_type* parse_escape(const char_type* q, std::error_code& ec)
+    {
+        if (q == end_input_)
+        {
+            offset_ = q - begin_input_;
+            report_error(json_errc::unexpected_eof, ec);
+            return q;
+        }
+        switch (*q)
+        {
+            case '\"':
+                string_buffer_.push_back('\"');
+                return q + 1;
+            case '\\':
+                string_buffer_.push_back('\\');
+                return q + 1;
+            case '/':
+                string_buffer_.push_back('/');
+                return q + 1;
+            case 'b':
+                string_buffer_.push_back('\b');
+                return q + 1;
+            case 'f':
+                string_buffer_.push_back('\f');
+                return q + 1;
+            case 'n':
+                string_buffer_.push_back('\n');
+                return q + 1;
+            case 'r':
+                string_buffer_.push_back('\r');
+                return q + 1;
+            case 't':
+                string_buffer_.push_back('\t');
+                return q + 1;
+            case 'u':
+            {
+                uint32_t cp = 0;
+                q = parse_hex4(q + 1, cp, ec);
+                if (ec) return q;
+                if (unicode_traits::is_high_surrogate(cp))
+                {
+                    if (end_input_ - q < 2 || q[0] != '\\' || q[1] != 'u')
+                    {
+                        offset_ = q - begin_input_;
+                        report_error(json_errc::expected_codepoint_surrogate_pair, ec);
+                        return q;
+                    }
+                    uint32_t cp2 = 0;
+                    q = parse_hex4(q + 2, cp2, ec);
+                    if (ec) return q;
+                    cp = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+                }
+                unicode_traits::convert(&cp, 1, string_buffer_);
+                return q;
+            }
+            default:
+                offset_ = q - begin_input_;
+                report_error(json_errc::illegal_escaped_character, ec);
+                return q;
+        }
+    }
+
+    const char_type* parse_hex4(const char_type* q, uint32_t& cp, std::error_code& ec)
+    {
+        for (int i = 0; i < 4; ++i, ++q)
+        {
+            if (q == end_input_)
+            {
+                offset_ = q - begin_input_;
+                report_error(json_errc::unexpected_eof, ec);
+                return q;
+            }
+            char_type c = *q;
+            cp *= 16;
+            if (c >= '0'  &&  c <= '9')
+            {
+                cp += c - '0';
+            }
+            else if (c >= 'a'  &&  c <= 'f')
+            {
+                cp += c - 'a' + 10;
+            }
+            else if (c >= 'A'  &&  c <= 'F')
+            {
+                cp += c - 'A' + 10;
+            }
+            else
+            {
+                offset_ = q - begin_input_;
+                report_error(json_errc::invalid_unicode_escape_sequence, ec);
+                return q;
+            }
+        }
+        return q;
+    }
+
+    static json_errc translate_conv_errc(unicode_traits::conv_errc result)
+    {
+        switch (result)
+        {
+            case unicode_traits::conv_errc::over_long_utf8_sequence:
+                return json_errc::over_long_utf8_sequence;
+            case unicode_traits::conv_errc::unpaired_high_surrogate:
+                return json_errc::unpaired_high_surrogate;
+            case unicode_traits::conv_errc::expected_continuation_byte:
+                return json_errc::expected_continuation_byte;
+            case unicode_traits::conv_errc::illegal_surrogate_value:
+                return json_errc::illegal_surrogate_value;
+            default:
+                return json_errc::illegal_codepoint;
+        }
+    }
+
+    void report_error(json_errc code, std::error_code& ec)
+    {
+        err_handler_(code, *this);
+        ec = code;
+        more_ = false;
+    }
+
+    // Line and column are only needed for error reporting, they are
+    // computed on demand from the offset of the current token
+    void advance_line() const
+    {
+        if (offset_ < line_offset_)
+        {
+            line_offset_ = 0;
+            line_ = 1;
+            line_start_ = 0;
+        }
+        for (std::size_t i = line_offset_; i < offset_; ++i)
+        {
+            char_type c = begin_input_[i];
+            if (c == '\n' || (c == '\r' && (begin_input_ + i + 1 == end_input_ || begin_input_[i+1] != '\n')))
+            {
+                ++line_;
+                line_start_ = i + 1;
+            }
+        }
+        line_offset_ = offset_;
+    }
+
+    json_parse_state parent() const
+    {
+        JSONCONS_ASSERT(state_stack_.size() >= 1);
+        return state_stack_.back();
+    }
+
+    void push_state(json_parse_state state)
+    {
+        state_stack_.push_back(state);
+    }
+
+    json_parse_state pop_state()
+    {
+        JSONCONS_ASSERT(!state_stack_.empty())
+        json_parse_state state = state_stack_.back();
+        state_stack_.pop_back();
+        return state;
+    }
+};
+
+template <class CharT, class TempAllocator>
+constexpr std::size_t basic_json_structural_parser<CharT,TempAllocator>::chunk_size;
+
+using json_structural_parser = basic_json_structural_parser<char>;
+using wjson_structural_parser = basic_json_structural_parser<wchar_t>;
+
+}
+
+#endif
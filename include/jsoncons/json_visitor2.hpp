@@ -1715,6 +1715,24 @@ namespace jsoncons {
                 return destination_->typed_array(s, tag, context, ec);
             }
         }
+
+        bool visit_begin_multi_dim(const jsoncons::span<const size_t>& shape,
+                                   semantic_tag tag,
+                                   const ser_context& context, 
+                                   std::error_code& ec) override
+        {
+            if (level_stack_.back().is_key() || level_stack_.back().target() == target_t::buffer)
+            {
+                return basic_json_visitor2<CharT>::visit_begin_multi_dim(shape, tag, context, ec);
+            }
+            else
+            {
+                // The destination receives the shape, the first of the two elements
+                level_stack_.emplace_back(target_t::destination, container_t::array);
+                level_stack_.back().advance();
+                return destination_->begin_multi_dim(shape, tag, context, ec);
+            }
+        }
     };
 
     template <class CharT>
@@ -0,0 +1,676 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_LAZY_JSON_HPP
+#define JSONCONS_LAZY_JSON_HPP
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <utility> // std::forward
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_structural_parser.hpp>
+
+namespace jsoncons {
+
+    template <class Json>
+    class basic_lazy_json_document;
+
+    // basic_lazy_json
+    // A view of a value in a basic_lazy_json_document. Nothing is parsed
+    // until the value is materialized with materialize() or as<T>()
+
+    template <class Json>
+    class basic_lazy_json
+    {
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<char_type>;
+        using document_type = basic_lazy_json_document<Json>;
+
+        class array_iterator;
+        class object_iterator;
+        class key_value_type;
+    private:
+        friend class basic_lazy_json_document<Json>;
+
+        const document_type* doc_;
+        std::size_t pos_;
+
+        basic_lazy_json(const document_type* doc, std::size_t pos)
+            : doc_(doc), pos_(pos)
+        {
+        }
+    public:
+        basic_lazy_json(const basic_lazy_json&) = default;
+        basic_lazy_json& operator=(const basic_lazy_json&) = default;
+
+        bool is_null() const
+        {
+            return first() == 'n';
+        }
+
+        bool is_bool() const
+        {
+            return first() == 't' || first() == 'f';
+        }
+
+        bool is_string() const
+        {
+            return first() == '\"';
+        }
+
+        bool is_number() const
+        {
+            char_type c = first();
+            return c == '-' || (c >= '0' && c <= '9');
+        }
+
+        bool is_object() const
+        {
+            return first() == '{';
+        }
+
+        bool is_array() const
+        {
+            return first() == '[';
+        }
+
+        // The JSON text of this value
+        string_view_type text() const
+        {
+            return doc_->value_text(pos_);
+        }
+
+        // The number of elements of an array or members of an object, 0 otherwise
+        std::size_t size() const
+        {
+            std::size_t count = 0;
+            if (is_object())
+            {
+                for (auto it = object_begin(); it != object_end(); ++it)
+                {
+                    ++count;
+                }
+            }
+            else if (is_array())
+            {
+                for (auto it = array_begin(); it != array_end(); ++it)
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        bool empty() const
+        {
+            // An empty object or array is two tokens, the brackets
+            return (is_object() || is_array()) && doc_->end_of(pos_) == pos_ + 2;
+        }
+
+        object_iterator find(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            string_type buffer;
+            for (std::size_t pos = pos_ + 1; doc_->token(pos) == '\"'; pos = doc_->next_member(pos))
+            {
+                if (doc_->key(pos, buffer) == key)
+                {
+                    return object_iterator(doc_, pos);
+                }
+            }
+            return object_end();
+        }
+
+        bool contains(const string_view_type& key) const
+        {
+            return is_object() && find(key) != object_end();
+        }
+
+        basic_lazy_json at(const string_view_type& key) const
+        {
+            auto it = find(key);
+            if (it == object_end())
+            {
+                JSONCONS_THROW(key_not_found(key.data(),key.length()));
+            }
+            return it->value();
+        }
+
+        basic_lazy_json at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            auto it = array_begin();
+            for (std::size_t n = 0; n < i && it != array_end(); ++n)
+            {
+                ++it;
+            }
+            if (it == array_end())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return *it;
+        }
+
+        range<object_iterator, object_iterator> object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return range<object_iterator, object_iterator>(object_begin(), object_end());
+        }
+
+        range<array_iterator, array_iterator> array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return range<array_iterator, array_iterator>(array_begin(), array_end());
+        }
+
+        // Parses this value and its children into a Json
+        Json materialize() const
+        {
+            return doc_->materialize(pos_);
+        }
+
+        template <class T, class... Args>
+        T as(Args&&... args) const
+        {
+            return materialize().template as<T>(std::forward<Args>(args)...);
+        }
+
+    private:
+        char_type first() const
+        {
+            return doc_->token(pos_);
+        }
+
+        object_iterator object_begin() const
+        {
+            return object_iterator(doc_, pos_ + 1);
+        }
+
+        object_iterator object_end() const
+        {
+            return object_iterator(doc_, doc_->end_of(pos_) - 1);
+        }
+
+        array_iterator array_begin() const
+        {
+            return array_iterator(doc_, pos_ + 1);
+        }
+
+        array_iterator array_end() const
+        {
+            return array_iterator(doc_, doc_->end_of(pos_) - 1);
+        }
+    };
+
+    template <class Json>
+    class basic_lazy_json<Json>::key_value_type
+    {
+        friend class basic_lazy_json<Json>::object_iterator;
+
+        const document_type* doc_;
+        std::size_t pos_;
+        string_type buffer_;
+        string_view_type key_;
+        bool escaped_;
+
+        key_value_type(const document_type* doc, std::size_t pos)
+            : doc_(doc), pos_(pos), escaped_(false)
+        {
+        }
+
+        void load()
+        {
+            key_ = doc_->key(pos_, buffer_);
+            // An escaped name is never empty
+            escaped_ = !buffer_.empty() && key_.data() == buffer_.data();
+        }
+    public:
+        // The unescaped member name
+        string_view_type key() const
+        {
+            // A copy must not refer to the buffer of the original
+            return escaped_ ? string_view_type(buffer_.data(), buffer_.size()) : key_;
+        }
+
+        basic_lazy_json value() const
+        {
+            return basic_lazy_json(doc_, pos_ + 2);
+        }
+    };
+
+    template <class Json>
+    class basic_lazy_json<Json>::object_iterator
+    {
+        friend class basic_lazy_json<Json>;
+
+        key_value_type member_;
+
+        object_iterator(const document_type* doc, std::size_t pos)
+            : member_(doc, pos)
+        {
+            if (doc->token(pos) == '\"')
+            {
+                member_.load();
+            }
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = key_value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const key_value_type*;
+        using reference = const key_value_type&;
+
+        reference operator*() const
+        {
+            return member_;
+        }
+
+        pointer operator->() const
+        {
+            return &member_;
+        }
+
+        object_iterator& operator++()
+        {
+            member_.pos_ = member_.doc_->next_member(member_.pos_);
+            if (member_.doc_->token(member_.pos_) == '\"')
+            {
+                member_.load();
+            }
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const object_iterator& rhs) const
+        {
+            return member_.pos_ == rhs.member_.pos_;
+        }
+
+        bool operator!=(const object_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    template <class Json>
+    class basic_lazy_json<Json>::array_iterator
+    {
+        friend class basic_lazy_json<Json>;
+
+        basic_lazy_json value_;
+
+        array_iterator(const document_type* doc, std::size_t pos)
+            : value_(doc, pos)
+        {
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_lazy_json;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_lazy_json*;
+        using reference = const basic_lazy_json&;
+
+        reference operator*() const
+        {
+            return value_;
+        }
+
+        pointer operator->() const
+        {
+            return &value_;
+        }
+
+        array_iterator& operator++()
+        {
+            value_.pos_ = value_.doc_->next_element(value_.pos_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const array_iterator& rhs) const
+        {
+            return value_.pos_ == rhs.value_.pos_;
+        }
+
+        bool operator!=(const array_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    // basic_lazy_json_document
+    // Indexes a JSON text with one structural pass, recording where each
+    // value starts and ends. Values are only parsed when they are materialized.
+    // The text must remain valid for the lifetime of the document, and the
+    // document for the lifetime of the values obtained from it.
+
+    template <class Json>
+    class basic_lazy_json_document
+    {
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<char_type>;
+        using value_type = basic_lazy_json<Json>;
+    private:
+        friend class basic_lazy_json<Json>;
+
+        string_view_type input_;
+        // The offsets of the structural characters, the opening quotes of strings,
+        // and the first characters of other values
+        std::vector<std::size_t> offsets_;
+        // For the token that starts a value, the token that follows the value
+        std::vector<std::size_t> ends_;
+    public:
+        basic_lazy_json_document() = default;
+
+        basic_lazy_json_document(const basic_lazy_json_document&) = default;
+        basic_lazy_json_document(basic_lazy_json_document&&) = default;
+        basic_lazy_json_document& operator=(const basic_lazy_json_document&) = default;
+        basic_lazy_json_document& operator=(basic_lazy_json_document&&) = default;
+
+        static basic_lazy_json_document parse(const string_view_type& s)
+        {
+            basic_lazy_json_document doc;
+            std::error_code ec;
+            std::size_t offset = doc.build(s, ec);
+            if (ec)
+            {
+                std::size_t line, column;
+                doc.line_and_column(offset, line, column);
+                JSONCONS_THROW(ser_error(ec, line, column));
+            }
+            return doc;
+        }
+
+        static basic_lazy_json_document parse(const string_view_type& s, std::error_code& ec)
+        {
+            basic_lazy_json_document doc;
+            doc.build(s, ec);
+            return doc;
+        }
+
+        value_type root() const
+        {
+            return value_type(this, 0);
+        }
+
+        string_view_type input() const
+        {
+            return input_;
+        }
+
+    private:
+        // Returns the offset of the error, if any
+        std::size_t build(const string_view_type& s, std::error_code& ec)
+        {
+            input_ = s;
+            offsets_.clear();
+            ends_.clear();
+
+            jsoncons::detail::json_structural_indexer<char_type> indexer;
+            offsets_.reserve(s.size() / 8);
+            indexer.index(s.data(), s.size(), offsets_);
+            ends_.resize(offsets_.size());
+
+            enum class expect {value, value_or_end, key, key_or_end, colon, comma_or_end, done};
+
+            // The token indices of the open containers
+            std::vector<std::size_t> stack;
+            expect state = expect::value;
+
+            for (std::size_t i = 0; i < offsets_.size(); ++i)
+            {
+                const char_type c = input_[offsets_[i]];
+                switch (state)
+                {
+                    case expect::value:
+                    case expect::value_or_end:
+                        switch (c)
+                        {
+                            case '{':
+                                stack.push_back(i);
+                                state = expect::key_or_end;
+                                break;
+                            case '[':
+                                stack.push_back(i);
+                                state = expect::value_or_end;
+                                break;
+                            case ']':
+                                if (state != expect::value_or_end)
+                                {
+                                    ec = json_errc::expected_value;
+                                    return offsets_[i];
+                                }
+                                close(i, stack, state);
+                                break;
+                            case '}':case ':':case ',':
+                                ec = json_errc::expected_value;
+                                return offsets_[i];
+                            default:
+                                ends_[i] = i + 1;
+                                state = stack.empty() ? expect::done : expect::comma_or_end;
+                                break;
+                        }
+                        break;
+                    case expect::key:
+                    case expect::key_or_end:
+                        switch (c)
+                        {
+                            case '\"':
+                                ends_[i] = i + 1;
+                                state = expect::colon;
+                                break;
+                            case '}':
+                                if (state != expect::key_or_end)
+                                {
+                                    ec = json_errc::extra_comma;
+                                    return offsets_[i];
+                                }
+                                close(i, stack, state);
+                                break;
+                            case '\'':
+                                ec = json_errc::single_quote;
+                                return offsets_[i];
+                            default:
+                                ec = json_errc::expected_key;
+                                return offsets_[i];
+                        }
+                        break;
+                    case expect::colon:
+                        if (c != ':')
+                        {
+                            ec = json_errc::expected_colon;
+                            return offsets_[i];
+                        }
+                        state = expect::value;
+                        break;
+                    case expect::comma_or_end:
+                    {
+                        const bool in_object = input_[offsets_[stack.back()]] == '{';
+                        if (c == ',')
+                        {
+                            state = in_object ? expect::key : expect::value;
+                        }
+                        else if (c == (in_object ? '}' : ']'))
+                        {
+                            close(i, stack, state);
+                        }
+                        else
+                        {
+                            ec = in_object ? json_errc::expected_comma_or_rbrace : json_errc::expected_comma_or_rbracket;
+                            return offsets_[i];
+                        }
+                        break;
+                    }
+                    case expect::done:
+                        ec = json_errc::extra_character;
+                        return offsets_[i];
+                }
+            }
+            if (state != expect::done || indexer.in_string())
+            {
+                ec = json_errc::unexpected_eof;
+                return s.size();
+            }
+            return 0;
+        }
+
+        template <class State>
+        void close(std::size_t i, std::vector<std::size_t>& stack, State& state)
+        {
+            ends_[stack.back()] = i + 1;
+            stack.pop_back();
+            state = stack.empty() ? State::done : State::comma_or_end;
+        }
+
+        char_type token(std::size_t pos) const
+        {
+            return pos < offsets_.size() ? input_[offsets_[pos]] : char_type();
+        }
+
+        std::size_t end_of(std::size_t pos) const
+        {
+            return ends_[pos];
+        }
+
+        // The element that follows the element at pos, or the closing bracket
+        std::size_t next_element(std::size_t pos) const
+        {
+            std::size_t next = ends_[pos];
+            return token(next) == ',' ? next + 1 : next;
+        }
+
+        // The member that follows the member with the key at pos, or the closing brace
+        std::size_t next_member(std::size_t pos) const
+        {
+            std::size_t next = ends_[pos + 2];
+            return token(next) == ',' ? next + 1 : next;
+        }
+
+        static bool is_whitespace(char_type c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        string_view_type value_text(std::size_t pos) const
+        {
+            const std::size_t begin = offsets_[pos];
+            const std::size_t next = ends_[pos];
+            std::size_t end;
+            if (input_[begin] == '{' || input_[begin] == '[')
+            {
+                end = offsets_[next - 1] + 1;
+            }
+            else
+            {
+                end = next < offsets_.size() ? offsets_[next] : input_.size();
+                while (end > begin && is_whitespace(input_[end - 1]))
+                {
+                    --end;
+                }
+            }
+            return string_view_type(input_.data() + begin, end - begin);
+        }
+
+        // The member name at pos, unescaped into buffer if necessary
+        string_view_type key(std::size_t pos, string_type& buffer) const
+        {
+            string_view_type raw = value_text(pos);
+            string_view_type inner(raw.data() + 1, raw.size() - 2);
+            for (auto c : inner)
+            {
+                if (c == '\\')
+                {
+                    buffer = materialize(pos).template as<string_type>();
+                    return string_view_type(buffer.data(), buffer.size());
+                }
+            }
+            return inner;
+        }
+
+        Json materialize(std::size_t pos) const
+        {
+            string_view_type text = value_text(pos);
+
+            json_decoder<Json> decoder;
+            basic_json_parser<char_type> parser;
+            std::error_code ec;
+            parser.update(text.data(), text.size());
+            parser.finish_parse(decoder, ec);
+            if (!ec)
+            {
+                parser.check_done(ec);
+            }
+            if (ec)
+            {
+                std::size_t line, column;
+                line_and_column((text.data() - input_.data()) + parser.position(), line, column);
+                JSONCONS_THROW(ser_error(ec, line, column));
+            }
+            return decoder.get_result();
+        }
+
+        void line_and_column(std::size_t offset, std::size_t& line, std::size_t& column) const
+        {
+            line = 1;
+            std::size_t line_start = 0;
+            for (std::size_t i = 0; i < offset && i < input_.size(); ++i)
+            {
+                char_type c = input_[i];
+                if (c == '\n' || (c == '\r' && (i + 1 == input_.size() || input_[i+1] != '\n')))
+                {
+                    ++line;
+                    line_start = i + 1;
+                }
+            }
+            column = (offset - line_start) + 1;
+        }
+    };
+
+    using lazy_json = basic_lazy_json<json>;
+    using lazy_ojson = basic_lazy_json<ojson>;
+    using wlazy_json = basic_lazy_json<wjson>;
+    using wlazy_ojson = basic_lazy_json<wojson>;
+
+    using lazy_json_document = basic_lazy_json_document<json>;
+    using lazy_ojson_document = basic_lazy_json_document<ojson>;
+    using wlazy_json_document = basic_lazy_json_document<wjson>;
+    using wlazy_ojson_document = basic_lazy_json_document<wojson>;
+
+} // namespace jsoncons
+
+#endif
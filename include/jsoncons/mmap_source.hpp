@@ -0,0 +1,349 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <string>
+#include <cstring> // std::memcpy
+#include <cstdint>
+#include <system_error>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // mapped_file
+    // A read-only memory mapping of a whole file
+
+    class mapped_file
+    {
+        const void* data_;
+        std::size_t size_;
+        std::error_code ec_;
+
+        // Noncopyable
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+    public:
+        mapped_file() noexcept
+            : data_(nullptr), size_(0)
+        {
+        }
+
+        explicit mapped_file(const char* path)
+            : data_(nullptr), size_(0)
+        {
+            map_file(path);
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(other.data_), size_(other.size_), ec_(other.ec_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap_file();
+                data_ = other.data_;
+                size_ = other.size_;
+                ec_ = other.ec_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~mapped_file() noexcept
+        {
+            unmap_file();
+        }
+
+        const void* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        std::error_code error() const
+        {
+            return ec_;
+        }
+
+    private:
+    #if defined(_WIN32)
+        void map_file(const char* path)
+        {
+            HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(file, &size))
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                ::CloseHandle(file);
+                return;
+            }
+            // An empty file cannot be mapped, and needs no mapping
+            if (size.QuadPart > 0)
+            {
+                HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr)
+                {
+                    ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                    ::CloseHandle(file);
+                    return;
+                }
+                // The view keeps the mapping and the file open
+                const void* p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (p == nullptr)
+                {
+                    ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                }
+                else
+                {
+                    data_ = p;
+                    size_ = static_cast<std::size_t>(size.QuadPart);
+                }
+                ::CloseHandle(mapping);
+            }
+            ::CloseHandle(file);
+        }
+
+        void unmap_file() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+    #else
+        void map_file(const char* path)
+        {
+            int fd = ::open(path, O_RDONLY);
+            if (fd == -1)
+            {
+                ec_ = std::error_code(errno, std::system_category());
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ec_ = std::error_code(errno, std::system_category());
+                ::close(fd);
+                return;
+            }
+            // An empty file cannot be mapped, and needs no mapping
+            if (st.st_size > 0)
+            {
+                std::size_t size = static_cast<std::size_t>(st.st_size);
+                void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    ec_ = std::error_code(errno, std::system_category());
+                }
+                else
+                {
+    #if defined(MADV_SEQUENTIAL)
+                    ::madvise(p, size, MADV_SEQUENTIAL);
+    #endif
+                    data_ = p;
+                    size_ = size;
+                }
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(fd);
+        }
+
+        void unmap_file() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<void*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+    #endif
+    };
+
+} // namespace detail
+
+    // basic_mmap_source
+    // Maps a file read-only and presents it as one contiguous buffer.
+    // If the file cannot be mapped, is_error() returns true.
+
+    template <class CharT>
+    class basic_mmap_source
+    {
+    public:
+        using value_type = CharT;
+    private:
+        detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable
+        basic_mmap_source(const basic_mmap_source&) = delete;
+        basic_mmap_source& operator=(const basic_mmap_source&) = delete;
+    public:
+        basic_mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit basic_mmap_source(const char* path)
+            : file_(path),
+              data_(static_cast<const value_type*>(file_.data())),
+              current_(data_),
+              end_(data_ + file_.size()/sizeof(value_type))
+        {
+        }
+
+        explicit basic_mmap_source(const std::string& path)
+            : basic_mmap_source(path.c_str())
+        {
+        }
+
+        basic_mmap_source(basic_mmap_source&& other) noexcept
+            : file_(std::move(other.file_)), data_(other.data_), current_(other.current_), end_(other.end_)
+        {
+            other.data_ = nullptr;
+            other.current_ = nullptr;
+            other.end_ = nullptr;
+        }
+
+        basic_mmap_source& operator=(basic_mmap_source&& other) noexcept
+        {
+            if (this != &other)
+            {
+                file_ = std::move(other.file_);
+                data_ = other.data_;
+                current_ = other.current_;
+                end_ = other.end_;
+                other.data_ = nullptr;
+                other.current_ = nullptr;
+                other.end_ = nullptr;
+            }
+            return *this;
+        }
+
+        // The reason the file could not be mapped
+        std::error_code error() const
+        {
+            return file_.error();
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return file_.error() ? true : false;
+        }
+
+        std::size_t position() const
+        {
+            return current_ - data_;
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < count)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = count;
+            }
+            current_ += len;
+        }
+
+        char_result<value_type> peek()
+        {
+            return current_ < end_ ? char_result<value_type>{*current_, false} : char_result<value_type>{0, true};
+        }
+
+        span<const value_type> read_buffer()
+        {
+            const value_type* data = current_;
+            std::size_t length = end_ - current_;
+            current_ = end_;
+
+            return span<const value_type>(data, length);
+        }
+
+        // Returns the next length values, or as many as remain, in place
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, (std::size_t)(end_ - current_));
+            current_ += len;
+
+            return span<const value_type>(data, len);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < length)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = length;
+            }
+            if (len > 0)
+            {
+                std::memcpy(p, current_, len*sizeof(value_type));
+                current_  += len;
+            }
+            return len;
+        }
+    };
+
+    using mmap_source = basic_mmap_source<char>;
+    using mmap_binary_source = basic_mmap_source<uint8_t>;
+
+    template <class CharT>
+    struct is_contiguous_source<basic_mmap_source<CharT>> : std::true_type {};
+
+} // namespace jsoncons
+
+#endif
@@ -456,6 +456,10 @@ namespace type_traits {
     using
     container_reserve_t = decltype(std::declval<Container>().reserve(typename Container::size_type()));
 
+    template<class Container>
+    using
+    container_append_t = decltype(std::declval<Container>().append(std::declval<const typename Container::value_type*>(), std::size_t()));
+
     template<class Container>
     using
     container_data_t = decltype(std::declval<Container>().data());
@@ -569,6 +573,12 @@ namespace type_traits {
     using
     is_insertable = is_detected<container_insert_t, Container>;
 
+    // has_append
+
+    template<class Container>
+    using
+    has_append = is_detected<container_append_t, Container>;
+
     // has_data, has_data_exact
 
     template<class Container>
@@ -0,0 +1,334 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SHARED_JSON_HPP
+#define JSONCONS_SHARED_JSON_HPP
+
+#include <string>
+#include <vector>
+#include <memory> // std::shared_ptr
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <utility> // std::move
+#include <jsoncons/json.hpp>
+
+namespace jsoncons {
+
+    // basic_shared_json
+    // A document whose arrays and objects are immutable, reference counted nodes.
+    // The elements and member values of a node's basic_json are json_const_pointer
+    // values that refer to its child nodes, which the node keeps alive. Copying a
+    // document copies one pointer, and a modification clones only the nodes on the
+    // path from the root to the modified value; the rest are shared with the copies.
+
+    template <class Json>
+    class basic_shared_json
+    {
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using key_type = typename Json::key_type;
+    private:
+        struct node
+        {
+            // The child nodes, in the iteration order of value. Declared first, so 
+            // that value, which refers to them, is destroyed before them.
+            std::vector<std::shared_ptr<const node>> children;
+            Json value;
+
+            node(const Json& val)
+                : value(val)
+            {
+            }
+
+            node(Json&& val)
+                : value(std::move(val))
+            {
+            }
+        };
+
+        using node_ptr = std::shared_ptr<const node>;
+        using token_list = std::vector<std::basic_string<char_type>>;
+
+        node_ptr root_;
+    public:
+        basic_shared_json()
+            : root_(std::make_shared<node>(Json::null()))
+        {
+        }
+
+        explicit basic_shared_json(const Json& val)
+            : root_(make_node(val))
+        {
+        }
+
+        basic_shared_json(const basic_shared_json&) = default;
+        basic_shared_json(basic_shared_json&&) = default;
+        basic_shared_json& operator=(const basic_shared_json&) = default;
+        basic_shared_json& operator=(basic_shared_json&&) = default;
+
+        // A read only view of the document. Nested values are reached through
+        // json_const_pointer values and may be shared with other documents.
+        const Json& root() const
+        {
+            return root_->value;
+        }
+
+        // An independent deep copy
+        Json to_json() const
+        {
+            return deep_copy(root_->value);
+        }
+
+        // Replaces the value at the JSON Pointer location, or adds it if the location is
+        // a new object member, the index one past the end of an array, or "-"
+        void set(const string_view_type& location, const Json& val)
+        {
+            token_list tokens = split(location);
+            root_ = update(root_, tokens, 0, make_node(val));
+        }
+
+        // Removes the value at the JSON Pointer location
+        void erase(const string_view_type& location)
+        {
+            token_list tokens = split(location);
+            if (tokens.empty())
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Cannot erase the root"));
+            }
+            root_ = update(root_, tokens, 0, node_ptr());
+        }
+
+        // True if the two documents share their root, as they do after a copy
+        // and until either is modified
+        bool shares_root_with(const basic_shared_json& other) const
+        {
+            return root_ == other.root_;
+        }
+
+        friend bool operator==(const basic_shared_json& lhs, const basic_shared_json& rhs)
+        {
+            return lhs.root_ == rhs.root_ || lhs.root() == rhs.root();
+        }
+
+        friend bool operator!=(const basic_shared_json& lhs, const basic_shared_json& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static node_ptr make_node(const Json& val)
+        {
+            if (val.is_array())
+            {
+                auto n = std::make_shared<node>(Json(json_array_arg, val.tag()));
+                n->children.reserve(val.size());
+                n->value.reserve(val.size());
+                for (const auto& item : val.array_range())
+                {
+                    n->children.push_back(make_node(item));
+                    n->value.emplace_back(json_const_pointer_arg, &(n->children.back()->value));
+                }
+                return n;
+            }
+            else if (val.is_object())
+            {
+                auto n = std::make_shared<node>(Json(json_object_arg, val.tag()));
+                n->children.reserve(val.size());
+                n->value.reserve(val.size());
+                for (const auto& member : val.object_range())
+                {
+                    n->children.push_back(make_node(member.value()));
+                    n->value.try_emplace(member.key(), json_const_pointer_arg, &(n->children.back()->value));
+                }
+                return n;
+            }
+            else
+            {
+                return std::make_shared<node>(deep_copy(val));
+            }
+        }
+
+        // Returns a copy of n with the value at tokens[i...] replaced by child,
+        // or erased if child is null
+        static node_ptr update(const node_ptr& n, const token_list& tokens, std::size_t i, node_ptr child)
+        {
+            if (i == tokens.size())
+            {
+                return child;
+            }
+            const auto& token = tokens[i];
+            const bool last = i + 1 == tokens.size();
+
+            if (n->value.is_array())
+            {
+                std::size_t size = n->children.size();
+                std::size_t pos = (token.size() == 1 && token[0] == '-') ? size : to_index(token);
+                if (pos > size || (pos == size && (!last || !child)))
+                {
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Index out of range"));
+                }
+                if (pos < size)
+                {
+                    child = update(n->children[pos], tokens, i+1, std::move(child));
+                }
+
+                auto m = std::make_shared<node>(Json(json_array_arg, n->value.tag()));
+                m->children.reserve(size + 1);
+                m->value.reserve(size + 1);
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    if (k != pos)
+                    {
+                        m->children.push_back(n->children[k]);
+                    }
+                    else if (child)
+                    {
+                        m->children.push_back(child);
+                    }
+                }
+                if (pos == size)
+                {
+                    m->children.push_back(child);
+                }
+                for (const auto& c : m->children)
+                {
+                    m->value.emplace_back(json_const_pointer_arg, &(c->value));
+                }
+                return m;
+            }
+            else if (n->value.is_object())
+            {
+                string_view_type name(token.data(), token.size());
+                auto it = n->value.find(name);
+                bool found = it != n->value.object_range().end();
+                if (found)
+                {
+                    std::size_t pos = it - n->value.object_range().begin();
+                    child = update(n->children[pos], tokens, i+1, std::move(child));
+                }
+                else if (!last || !child)
+                {
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Key not found"));
+                }
+
+                auto m = std::make_shared<node>(Json(json_object_arg, n->value.tag()));
+                m->value.reserve(n->children.size() + 1);
+                std::size_t k = 0;
+                for (const auto& member : n->value.object_range())
+                {
+                    if (!(key_view(member.key()) == name))
+                    {
+                        m->value.try_emplace(member.key(), json_const_pointer_arg, &(n->children[k]->value));
+                    }
+                    else if (child)
+                    {
+                        m->value.try_emplace(member.key(), json_const_pointer_arg, &(child->value));
+                    }
+                    ++k;
+                }
+                if (!found)
+                {
+                    m->value.try_emplace(name, json_const_pointer_arg, &(child->value));
+                }
+
+                // Collect the children in the iteration order of the new object
+                m->children.reserve(m->value.size());
+                for (const auto& member : m->value.object_range())
+                {
+                    if (key_view(member.key()) == name)
+                    {
+                        m->children.push_back(child);
+                    }
+                    else
+                    {
+                        auto old = n->value.find(member.key());
+                        m->children.push_back(n->children[old - n->value.object_range().begin()]);
+                    }
+                }
+                return m;
+            }
+            else
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Not an array or object"));
+            }
+        }
+
+        static string_view_type key_view(const key_type& key)
+        {
+            return string_view_type(key.data(), key.size());
+        }
+
+        static std::size_t to_index(const std::basic_string<char_type>& token)
+        {
+            if (token.empty() || (token.size() > 1 && token[0] == '0'))
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Invalid array index"));
+            }
+            std::size_t pos = 0;
+            for (auto c : token)
+            {
+                if (c < '0' || c > '9')
+                {
+                    JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Invalid array index"));
+                }
+                pos = pos*10 + static_cast<std::size_t>(c - '0');
+            }
+            return pos;
+        }
+
+        // Splits a JSON Pointer (RFC 6901) into unescaped reference tokens
+        static token_list split(const string_view_type& location)
+        {
+            token_list tokens;
+            if (location.empty())
+            {
+                return tokens;
+            }
+            if (location[0] != '/')
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("A JSON Pointer must start with '/'"));
+            }
+            for (std::size_t i = 0; i < location.size(); ++i)
+            {
+                char_type c = location[i];
+                if (c == '/')
+                {
+                    tokens.emplace_back();
+                }
+                else if (c == '~')
+                {
+                    if (i + 1 < location.size() && location[i+1] == '0')
+                    {
+                        tokens.back().push_back('~');
+                    }
+                    else if (i + 1 < location.size() && location[i+1] == '1')
+                    {
+                        tokens.back().push_back('/');
+                    }
+                    else
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Invalid escape in JSON Pointer"));
+                    }
+                    ++i;
+                }
+                else
+                {
+                    tokens.back().push_back(c);
+                }
+            }
+            return tokens;
+        }
+    };
+
+    using shared_json = basic_shared_json<json>;
+    using shared_ojson = basic_shared_json<ojson>;
+    using wshared_json = basic_shared_json<wjson>;
+    using wshared_ojson = basic_shared_json<wojson>;
+
+} // namespace jsoncons
+
+#endif
@@ -380,6 +380,16 @@ namespace jsoncons {
             return span<const value_type>(data, length);
         }
 
+        // Returns the next length values, or as many as remain, in place
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, (std::size_t)(end_ - current_));
+            current_ += len;
+
+            return span<const value_type>(data, len);
+        }
+
         std::size_t read(value_type* p, std::size_t length)
         {
             std::size_t len;
@@ -582,6 +592,16 @@ namespace jsoncons {
             return span<const value_type>(data, length);
         }
 
+        // Returns the next length values, or as many as remain, in place
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, (std::size_t)(end_ - current_));
+            current_ += len;
+
+            return span<const value_type>(data, len);
+        }
+
         std::size_t read(value_type* p, std::size_t length)
         {
             std::size_t len;
@@ -768,6 +788,19 @@ namespace jsoncons {
     template <class Source>
     constexpr std::size_t source_reader<Source>::max_buffer_length;
 
+    // is_contiguous_source
+    // True if read_buffer returns all of the remaining input in one contiguous buffer,
+    // and read_span returns views of the input in place
+
+    template <class Source>
+    struct is_contiguous_source : std::false_type {};
+
+    template <class CharT>
+    struct is_contiguous_source<string_source<CharT>> : std::true_type {};
+
+    template <>
+    struct is_contiguous_source<bytes_source> : std::true_type {};
+
     #if !defined(JSONCONS_NO_DEPRECATED)
     using bin_stream_source = binary_stream_source;
     #endif
@@ -0,0 +1,1037 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_TAPE_JSON_HPP
+#define JSONCONS_TAPE_JSON_HPP
+
+#include <string>
+#include <vector>
+#include <cstring> // std::memcpy
+#include <iterator>
+#include <limits> // std::numeric_limits
+#include <type_traits>
+#include <utility> // std::forward
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Each value on a tape starts with a word holding the tape_type in the top 8 bits,
+    // the semantic_tag in the next 8 bits, and a 48 bit payload.
+    //
+    // null_value, bool_value  1 word, the payload of a bool is 0 or 1
+    // half_value              1 word, the payload is the half
+    // int64_value, uint64_value, double_value
+    //                         2 words, the second holds the bits of the value
+    // string_value            2 words, the payload is the offset in the string arena,
+    //                         the second word the length
+    // byte_string_value       3 words, the payload is the offset in the byte arena,
+    //                         the second word the length, the third the ext tag
+    // begin_array, begin_object
+    //                         2 words, the payload is the index past the matching end,
+    //                         the second word the number of elements or members
+    // end_array, end_object   1 word, the payload is the index of the matching begin
+    //
+    // An object member is a string_value, the name, followed by its value.
+
+    enum class tape_type : uint8_t
+    {
+        null_value,
+        bool_value,
+        int64_value,
+        uint64_value,
+        half_value,
+        double_value,
+        string_value,
+        byte_string_value,
+        begin_array,
+        end_array,
+        begin_object,
+        end_object
+    };
+
+    struct tape_word
+    {
+        static constexpr uint64_t payload_mask = (uint64_t(1) << 48) - 1;
+
+        static uint64_t make(tape_type type, semantic_tag tag, uint64_t payload)
+        {
+            return (static_cast<uint64_t>(type) << 56) | (static_cast<uint64_t>(tag) << 48) | (payload & payload_mask);
+        }
+
+        static tape_type type(uint64_t word)
+        {
+            return static_cast<tape_type>(word >> 56);
+        }
+
+        static semantic_tag tag(uint64_t word)
+        {
+            return static_cast<semantic_tag>((word >> 48) & 0xff);
+        }
+
+        static uint64_t payload(uint64_t word)
+        {
+            return word & payload_mask;
+        }
+    };
+
+} // namespace detail
+
+    template <class Json>
+    class basic_tape_json_document;
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class tape_json_decoder;
+
+    // basic_tape_json
+    // A read only view of a value in a basic_tape_json_document, with the const
+    // accessors of basic_json
+
+    template <class Json>
+    class basic_tape_json
+    {
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<char_type>;
+        using document_type = basic_tape_json_document<Json>;
+
+        class array_iterator;
+        class object_iterator;
+        class key_value_type;
+    private:
+        friend class basic_tape_json_document<Json>;
+
+        const document_type* doc_;
+        std::size_t pos_;
+
+        basic_tape_json(const document_type* doc, std::size_t pos)
+            : doc_(doc), pos_(pos)
+        {
+        }
+    public:
+        basic_tape_json(const basic_tape_json&) = default;
+        basic_tape_json& operator=(const basic_tape_json&) = default;
+
+        jsoncons::json_type type() const
+        {
+            switch (tape_type())
+            {
+                case detail::tape_type::null_value:
+                    return jsoncons::json_type::null_value;
+                case detail::tape_type::bool_value:
+                    return jsoncons::json_type::bool_value;
+                case detail::tape_type::int64_value:
+                    return jsoncons::json_type::int64_value;
+                case detail::tape_type::uint64_value:
+                    return jsoncons::json_type::uint64_value;
+                case detail::tape_type::half_value:
+                    return jsoncons::json_type::half_value;
+                case detail::tape_type::double_value:
+                    return jsoncons::json_type::double_value;
+                case detail::tape_type::string_value:
+                    return jsoncons::json_type::string_value;
+                case detail::tape_type::byte_string_value:
+                    return jsoncons::json_type::byte_string_value;
+                case detail::tape_type::begin_array:
+                    return jsoncons::json_type::array_value;
+                case detail::tape_type::begin_object:
+                    return jsoncons::json_type::object_value;
+                default:
+                    JSONCONS_UNREACHABLE();
+            }
+        }
+
+        semantic_tag tag() const
+        {
+            return detail::tape_word::tag(word());
+        }
+
+        bool is_null() const noexcept
+        {
+            return tape_type() == detail::tape_type::null_value;
+        }
+
+        bool is_bool() const noexcept
+        {
+            return tape_type() == detail::tape_type::bool_value;
+        }
+
+        bool is_int64() const noexcept
+        {
+            switch (tape_type())
+            {
+                case detail::tape_type::int64_value:
+                    return true;
+                case detail::tape_type::uint64_value:
+                    return doc_->tape_[pos_ + 1] <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+                default:
+                    return false;
+            }
+        }
+
+        bool is_uint64() const noexcept
+        {
+            switch (tape_type())
+            {
+                case detail::tape_type::uint64_value:
+                    return true;
+                case detail::tape_type::int64_value:
+                    return static_cast<int64_t>(doc_->tape_[pos_ + 1]) >= 0;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_half() const noexcept
+        {
+            return tape_type() == detail::tape_type::half_value;
+        }
+
+        bool is_double() const noexcept
+        {
+            return tape_type() == detail::tape_type::double_value;
+        }
+
+        bool is_number() const noexcept
+        {
+            switch (tape_type())
+            {
+                case detail::tape_type::int64_value:
+                case detail::tape_type::uint64_value:
+                case detail::tape_type::half_value:
+                case detail::tape_type::double_value:
+                    return true;
+                case detail::tape_type::string_value:
+                    return tag() == semantic_tag::bigint ||
+                           tag() == semantic_tag::bigdec ||
+                           tag() == semantic_tag::bigfloat;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_string() const noexcept
+        {
+            return tape_type() == detail::tape_type::string_value;
+        }
+
+        bool is_byte_string() const noexcept
+        {
+            return tape_type() == detail::tape_type::byte_string_value;
+        }
+
+        bool is_array() const noexcept
+        {
+            return tape_type() == detail::tape_type::begin_array;
+        }
+
+        bool is_object() const noexcept
+        {
+            return tape_type() == detail::tape_type::begin_object;
+        }
+
+        std::size_t size() const
+        {
+            return (is_array() || is_object()) ? static_cast<std::size_t>(doc_->tape_[pos_ + 1]) : 0;
+        }
+
+        bool empty() const
+        {
+            switch (tape_type())
+            {
+                case detail::tape_type::string_value:
+                case detail::tape_type::byte_string_value:
+                case detail::tape_type::begin_array:
+                case detail::tape_type::begin_object:
+                    return doc_->tape_[pos_ + 1] == 0;
+                default:
+                    return false;
+            }
+        }
+
+        object_iterator find(const string_view_type& name) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(name.data(),name.length()));
+            }
+            const std::size_t last = end_pos();
+            for (std::size_t pos = pos_ + 2; pos < last; pos = doc_->next(pos + 2))
+            {
+                if (doc_->string_at(pos) == name)
+                {
+                    return object_iterator(doc_, pos);
+                }
+            }
+            return object_iterator(doc_, last);
+        }
+
+        bool contains(const string_view_type& name) const noexcept
+        {
+            if (!is_object())
+            {
+                return false;
+            }
+            return find(name) != object_iterator(doc_, end_pos());
+        }
+
+        basic_tape_json at(const string_view_type& name) const
+        {
+            auto it = find(name);
+            if (it == object_iterator(doc_, end_pos()))
+            {
+                JSONCONS_THROW(key_not_found(name.data(),name.length()));
+            }
+            return it->value();
+        }
+
+        basic_tape_json operator[](const string_view_type& name) const
+        {
+            return at(name);
+        }
+
+        basic_tape_json at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            if (i >= size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            std::size_t pos = pos_ + 2;
+            for (std::size_t n = 0; n < i; ++n)
+            {
+                pos = doc_->next(pos);
+            }
+            return basic_tape_json(doc_, pos);
+        }
+
+        basic_tape_json operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        range<object_iterator, object_iterator> object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return range<object_iterator, object_iterator>(object_iterator(doc_, pos_ + 2), object_iterator(doc_, end_pos()));
+        }
+
+        range<array_iterator, array_iterator> array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return range<array_iterator, array_iterator>(array_iterator(doc_, pos_ + 2), array_iterator(doc_, end_pos()));
+        }
+
+        bool as_bool() const
+        {
+            return materialize().as_bool();
+        }
+
+        template <class IntegerType>
+        IntegerType as_integer() const
+        {
+            return materialize().template as_integer<IntegerType>();
+        }
+
+        double as_double() const
+        {
+            return materialize().as_double();
+        }
+
+        string_view_type as_string_view() const
+        {
+            if (!is_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            return doc_->string_at(pos_);
+        }
+
+        string_type as_string() const
+        {
+            if (is_string())
+            {
+                string_view_type sv = doc_->string_at(pos_);
+                return string_type(sv.data(), sv.size());
+            }
+            return materialize().as_string();
+        }
+
+        byte_string_view as_byte_string_view() const
+        {
+            if (!is_byte_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+            }
+            return doc_->bytes_at(pos_);
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_type>::value,T>::type
+        as() const
+        {
+            return as_string();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+        as() const
+        {
+            return as_string_view();
+        }
+
+        // Other conversions go through Json, which for a number, bool or null
+        // is built on the stack without allocating
+        template <class T, class... Args>
+        typename std::enable_if<!std::is_same<T,string_type>::value && !std::is_same<T,string_view_type>::value,T>::type
+        as(Args&&... args) const
+        {
+            return materialize().template as<T>(std::forward<Args>(args)...);
+        }
+
+        // Sends the events for this value to a visitor
+        void dump(basic_json_visitor<char_type>& visitor) const
+        {
+            std::error_code ec;
+            dump(visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        void dump(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+        {
+            doc_->dump(pos_, visitor, ec);
+            visitor.flush();
+        }
+
+        // Copies this value into a Json
+        Json materialize() const
+        {
+            const semantic_tag tag = this->tag();
+            switch (tape_type())
+            {
+                case detail::tape_type::null_value:
+                    return Json(null_type(), tag);
+                case detail::tape_type::bool_value:
+                    return Json(payload() != 0, tag);
+                case detail::tape_type::int64_value:
+                    return Json(static_cast<int64_t>(doc_->tape_[pos_ + 1]), tag);
+                case detail::tape_type::uint64_value:
+                    return Json(doc_->tape_[pos_ + 1], tag);
+                case detail::tape_type::half_value:
+                    return Json(half_arg, static_cast<uint16_t>(payload()), tag);
+                case detail::tape_type::double_value:
+                {
+                    double d;
+                    std::memcpy(&d, &doc_->tape_[pos_ + 1], sizeof(d));
+                    return Json(d, tag);
+                }
+                default:
+                {
+                    json_decoder<Json> decoder;
+                    dump(decoder);
+                    return decoder.get_result();
+                }
+            }
+        }
+
+    private:
+        uint64_t word() const
+        {
+            return doc_->tape_[pos_];
+        }
+
+        detail::tape_type tape_type() const
+        {
+            return detail::tape_word::type(word());
+        }
+
+        uint64_t payload() const
+        {
+            return detail::tape_word::payload(word());
+        }
+
+        // The index of the end_array or end_object
+        std::size_t end_pos() const
+        {
+            return static_cast<std::size_t>(payload()) - 1;
+        }
+    };
+
+    template <class Json>
+    class basic_tape_json<Json>::key_value_type
+    {
+        friend class basic_tape_json<Json>::object_iterator;
+
+        const document_type* doc_;
+        std::size_t pos_;
+
+        key_value_type(const document_type* doc, std::size_t pos)
+            : doc_(doc), pos_(pos)
+        {
+        }
+    public:
+        string_view_type key() const
+        {
+            return doc_->string_at(pos_);
+        }
+
+        basic_tape_json value() const
+        {
+            return basic_tape_json(doc_, pos_ + 2);
+        }
+    };
+
+    template <class Json>
+    class basic_tape_json<Json>::object_iterator
+    {
+        friend class basic_tape_json<Json>;
+
+        key_value_type member_;
+
+        object_iterator(const document_type* doc, std::size_t pos)
+            : member_(doc, pos)
+        {
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = key_value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const key_value_type*;
+        using reference = const key_value_type&;
+
+        reference operator*() const
+        {
+            return member_;
+        }
+
+        pointer operator->() const
+        {
+            return &member_;
+        }
+
+        object_iterator& operator++()
+        {
+            member_.pos_ = member_.doc_->next(member_.pos_ + 2);
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const object_iterator& rhs) const
+        {
+            return member_.pos_ == rhs.member_.pos_;
+        }
+
+        bool operator!=(const object_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    template <class Json>
+    class basic_tape_json<Json>::array_iterator
+    {
+        friend class basic_tape_json<Json>;
+
+        basic_tape_json value_;
+
+        array_iterator(const document_type* doc, std::size_t pos)
+            : value_(doc, pos)
+        {
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_tape_json;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_tape_json*;
+        using reference = const basic_tape_json&;
+
+        reference operator*() const
+        {
+            return value_;
+        }
+
+        pointer operator->() const
+        {
+            return &value_;
+        }
+
+        array_iterator& operator++()
+        {
+            value_.pos_ = value_.doc_->next(value_.pos_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const array_iterator& rhs) const
+        {
+            return value_.pos_ == rhs.value_.pos_;
+        }
+
+        bool operator!=(const array_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    // basic_tape_json_document
+    // An immutable JSON document held in one array of 64 bit words, the tape,
+    // with the characters of all strings in one arena, and the bytes of all
+    // byte strings in another.
+
+    template <class Json>
+    class basic_tape_json_document
+    {
+    public:
+        using json_type = Json;
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+        using string_type = std::basic_string<char_type>;
+        using value_type = basic_tape_json<Json>;
+    private:
+        friend class basic_tape_json<Json>;
+        template <class J,class A>
+        friend class tape_json_decoder;
+
+        std::vector<uint64_t> tape_;
+        string_type strings_;
+        std::vector<uint8_t> bytes_;
+    public:
+        basic_tape_json_document()
+            : tape_{detail::tape_word::make(detail::tape_type::null_value, semantic_tag::none, 0)}
+        {
+        }
+
+        basic_tape_json_document(const basic_tape_json_document&) = default;
+        basic_tape_json_document(basic_tape_json_document&&) = default;
+        basic_tape_json_document& operator=(const basic_tape_json_document&) = default;
+        basic_tape_json_document& operator=(basic_tape_json_document&&) = default;
+
+        static basic_tape_json_document parse(const string_view_type& s,
+                                              const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            tape_json_decoder<Json> decoder;
+            basic_json_parser<char_type> parser(options);
+            parser.update(s.data(), s.size());
+            parser.finish_parse(decoder);
+            parser.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(ser_error(json_errc::unexpected_eof, parser.line(), parser.column()));
+            }
+            return decoder.get_result();
+        }
+
+        value_type root() const
+        {
+            return value_type(this, 0);
+        }
+
+        // The number of words in the tape
+        std::size_t tape_size() const
+        {
+            return tape_.size();
+        }
+
+        // The memory held by the tape and the arenas
+        std::size_t memory_size() const
+        {
+            return tape_.capacity() * sizeof(uint64_t) + strings_.capacity() * sizeof(char_type) + bytes_.capacity();
+        }
+
+    private:
+        // The index of the value that follows the value at pos
+        std::size_t next(std::size_t pos) const
+        {
+            switch (detail::tape_word::type(tape_[pos]))
+            {
+                case detail::tape_type::null_value:
+                case detail::tape_type::bool_value:
+                case detail::tape_type::half_value:
+                    return pos + 1;
+                case detail::tape_type::byte_string_value:
+                    return pos + 3;
+                case detail::tape_type::begin_array:
+                case detail::tape_type::begin_object:
+                    return static_cast<std::size_t>(detail::tape_word::payload(tape_[pos]));
+                default:
+                    return pos + 2;
+            }
+        }
+
+        string_view_type string_at(std::size_t pos) const
+        {
+            return string_view_type(strings_.data() + detail::tape_word::payload(tape_[pos]),
+                                    static_cast<std::size_t>(tape_[pos + 1]));
+        }
+
+        byte_string_view bytes_at(std::size_t pos) const
+        {
+            return byte_string_view(bytes_.data() + detail::tape_word::payload(tape_[pos]),
+                                    static_cast<std::size_t>(tape_[pos + 1]));
+        }
+
+        void dump(std::size_t pos, basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+        {
+            const std::size_t last = next(pos);
+            // For each open container, whether it is an object
+            std::vector<bool> in_object;
+            bool expect_key = false;
+            ser_context context;
+
+            while (pos < last && !ec)
+            {
+                const uint64_t word = tape_[pos];
+                const semantic_tag tag = detail::tape_word::tag(word);
+                const detail::tape_type type = detail::tape_word::type(word);
+                if (expect_key && type == detail::tape_type::string_value)
+                {
+                    visitor.key(string_at(pos), context, ec);
+                    pos += 2;
+                    expect_key = false;
+                    continue;
+                }
+                switch (type)
+                {
+                    case detail::tape_type::null_value:
+                        visitor.null_value(tag, context, ec);
+                        break;
+                    case detail::tape_type::bool_value:
+                        visitor.bool_value(detail::tape_word::payload(word) != 0, tag, context, ec);
+                        break;
+                    case detail::tape_type::int64_value:
+                        visitor.int64_value(static_cast<int64_t>(tape_[pos + 1]), tag, context, ec);
+                        break;
+                    case detail::tape_type::uint64_value:
+                        visitor.uint64_value(tape_[pos + 1], tag, context, ec);
+                        break;
+                    case detail::tape_type::half_value:
+                        visitor.half_value(static_cast<uint16_t>(detail::tape_word::payload(word)), tag, context, ec);
+                        break;
+                    case detail::tape_type::double_value:
+                    {
+                        double d;
+                        std::memcpy(&d, &tape_[pos + 1], sizeof(d));
+                        visitor.double_value(d, tag, context, ec);
+                        break;
+                    }
+                    case detail::tape_type::string_value:
+                        visitor.string_value(string_at(pos), tag, context, ec);
+                        break;
+                    case detail::tape_type::byte_string_value:
+                        if (tag == semantic_tag::ext)
+                        {
+                            visitor.byte_string_value(bytes_at(pos), tape_[pos + 2], context, ec);
+                        }
+                        else
+                        {
+                            visitor.byte_string_value(bytes_at(pos), tag, context, ec);
+                        }
+                        break;
+                    case detail::tape_type::begin_array:
+                        visitor.begin_array(static_cast<std::size_t>(tape_[pos + 1]), tag, context, ec);
+                        in_object.push_back(false);
+                        pos += 2;
+                        continue;
+                    case detail::tape_type::begin_object:
+                        visitor.begin_object(static_cast<std::size_t>(tape_[pos + 1]), tag, context, ec);
+                        in_object.push_back(true);
+                        expect_key = true;
+                        pos += 2;
+                        continue;
+                    case detail::tape_type::end_array:
+                        visitor.end_array(context, ec);
+                        in_object.pop_back();
+                        break;
+                    case detail::tape_type::end_object:
+                        visitor.end_object(context, ec);
+                        in_object.pop_back();
+                        break;
+                }
+                pos = (type == detail::tape_type::end_array || type == detail::tape_type::end_object) ? pos + 1 : next(pos);
+                expect_key = !in_object.empty() && in_object.back();
+            }
+        }
+    };
+
+    // tape_json_decoder
+    // A visitor that records the events it receives on the tape of a basic_tape_json_document
+
+    template <class Json,class TempAllocator>
+    class tape_json_decoder final : public basic_json_visitor<typename Json::char_type>
+    {
+    public:
+        using char_type = typename Json::char_type;
+        using typename basic_json_visitor<char_type>::string_view_type;
+        using document_type = basic_tape_json_document<Json>;
+    private:
+        struct structure_info
+        {
+            std::size_t pos;
+            std::size_t count;
+        };
+
+        using temp_allocator_type = TempAllocator;
+        using structure_info_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info>;
+
+        document_type result_;
+        std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+        bool is_valid_;
+    public:
+        tape_json_decoder(const temp_allocator_type& temp_alloc = temp_allocator_type())
+            : structure_stack_(temp_alloc),
+              is_valid_(false)
+        {
+            structure_stack_.reserve(100);
+        }
+
+        void reset()
+        {
+            is_valid_ = false;
+            structure_stack_.clear();
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+        document_type get_result()
+        {
+            JSONCONS_ASSERT(is_valid_);
+            is_valid_ = false;
+            result_.tape_.shrink_to_fit();
+            result_.strings_.shrink_to_fit();
+            result_.bytes_.shrink_to_fit();
+            return std::move(result_);
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        void begin_value()
+        {
+            if (structure_stack_.empty())
+            {
+                result_.tape_.clear();
+                result_.strings_.clear();
+                result_.bytes_.clear();
+                is_valid_ = false;
+            }
+            else if (detail::tape_word::type(result_.tape_[structure_stack_.back().pos]) == detail::tape_type::begin_array)
+            {
+                ++structure_stack_.back().count;
+            }
+        }
+
+        // Returns false when the root value is complete
+        bool end_value()
+        {
+            if (structure_stack_.empty())
+            {
+                is_valid_ = true;
+                return false;
+            }
+            return true;
+        }
+
+        void push_word(detail::tape_type type, semantic_tag tag, uint64_t payload)
+        {
+            result_.tape_.push_back(detail::tape_word::make(type, tag, payload));
+        }
+
+        void push_string(const string_view_type& sv, semantic_tag tag)
+        {
+            push_word(detail::tape_type::string_value, tag, result_.strings_.size());
+            result_.tape_.push_back(sv.size());
+            result_.strings_.append(sv.data(), sv.size());
+        }
+
+        bool begin_structure(detail::tape_type type, semantic_tag tag)
+        {
+            begin_value();
+            structure_stack_.push_back(structure_info{result_.tape_.size(), 0});
+            push_word(type, tag, 0);
+            result_.tape_.push_back(0);
+            return true;
+        }
+
+        bool end_structure(detail::tape_type type)
+        {
+            JSONCONS_ASSERT(!structure_stack_.empty());
+            const structure_info info = structure_stack_.back();
+            structure_stack_.pop_back();
+            push_word(type, semantic_tag::none, info.pos);
+            uint64_t& begin = result_.tape_[info.pos];
+            begin = detail::tape_word::make(detail::tape_word::type(begin), detail::tape_word::tag(begin), result_.tape_.size());
+            result_.tape_[info.pos + 1] = info.count;
+            return end_value();
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return begin_structure(detail::tape_type::begin_object, tag);
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            return end_structure(detail::tape_type::end_object);
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return begin_structure(detail::tape_type::begin_array, tag);
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            return end_structure(detail::tape_type::end_array);
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            ++structure_stack_.back().count;
+            push_string(name, semantic_tag::none);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            push_string(sv, tag);
+            return end_value();
+        }
+
+        bool visit_byte_string(const byte_string_view& b,
+                               semantic_tag tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::byte_string_value, tag, result_.bytes_.size());
+            result_.tape_.push_back(b.size());
+            result_.tape_.push_back(0);
+            result_.bytes_.insert(result_.bytes_.end(), b.begin(), b.end());
+            return end_value();
+        }
+
+        bool visit_byte_string(const byte_string_view& b,
+                               uint64_t ext_tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::byte_string_value, semantic_tag::ext, result_.bytes_.size());
+            result_.tape_.push_back(b.size());
+            result_.tape_.push_back(ext_tag);
+            result_.bytes_.insert(result_.bytes_.end(), b.begin(), b.end());
+            return end_value();
+        }
+
+        bool visit_int64(int64_t value,
+                         semantic_tag tag,
+                         const ser_context&,
+                         std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::int64_value, tag, 0);
+            result_.tape_.push_back(static_cast<uint64_t>(value));
+            return end_value();
+        }
+
+        bool visit_uint64(uint64_t value,
+                          semantic_tag tag,
+                          const ser_context&,
+                          std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::uint64_value, tag, 0);
+            result_.tape_.push_back(value);
+            return end_value();
+        }
+
+        bool visit_half(uint16_t value,
+                        semantic_tag tag,
+                        const ser_context&,
+                        std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::half_value, tag, value);
+            return end_value();
+        }
+
+        bool visit_double(double value,
+                          semantic_tag tag,
+                          const ser_context&,
+                          std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::double_value, tag, 0);
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(value));
+            result_.tape_.push_back(bits);
+            return end_value();
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::bool_value, tag, value ? 1 : 0);
+            return end_value();
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            push_word(detail::tape_type::null_value, tag, 0);
+            return end_value();
+        }
+    };
+
+    using tape_json = basic_tape_json<json>;
+    using tape_ojson = basic_tape_json<ojson>;
+    using wtape_json = basic_tape_json<wjson>;
+    using wtape_ojson = basic_tape_json<wojson>;
+
+    using tape_json_document = basic_tape_json_document<json>;
+    using tape_ojson_document = basic_tape_json_document<ojson>;
+    using wtape_json_document = basic_tape_json_document<wjson>;
+    using wtape_ojson_document = basic_tape_json_document<wojson>;
+
+} // namespace jsoncons
+
+#endif
@@ -24,6 +24,7 @@
 #include <limits>
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/more_type_traits.hpp>
+#include <jsoncons/detail/simd.hpp>
 
 namespace jsoncons { namespace unicode_traits {
 
@@ -361,6 +362,86 @@ namespace jsoncons { namespace unicode_traits {
         static constexpr bool value = (sizeof(T1) == sizeof(T2));
     }; 
 
+    // append_ascii
+    //
+    // Appends the ASCII characters [first,last) to target as code units of its value type.
+    // For a run of at least 16 characters, a basic_string is resized once and filled 
+    // with jsoncons::detail::copy_ascii, otherwise characters are appended one at a time.
+
+    template <class CharT,class Container>
+    typename std::enable_if<type_traits::is_basic_string<Container>::value>::type
+    append_ascii(const CharT* first, const CharT* last, Container& target)
+    {
+        if (last - first >= 16)
+        {
+            std::size_t offset = target.size();
+            target.resize(offset + static_cast<std::size_t>(last - first));
+            jsoncons::detail::copy_ascii(first, last, &target[offset]);
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                target.push_back(static_cast<typename Container::value_type>(*first));
+            }
+        }
+    }
+
+    template <class CharT,class Container>
+    typename std::enable_if<!type_traits::is_basic_string<Container>::value>::type
+    append_ascii(const CharT* first, const CharT* last, Container& target)
+    {
+        for (; first != last; ++first)
+        {
+            target.push_back(static_cast<typename Container::value_type>(*first));
+        }
+    }
+
+    // Appends the run of ASCII characters that starts at data to target, and returns a 
+    // pointer past it. The first 16 are appended one at a time, which is cheaper for the 
+    // short runs between the accented letters of most non-English text, and the rest in bulk.
+
+    template <class CharT,class Container>
+    const CharT* append_ascii_run(const CharT* data, const CharT* last, Container& target)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        const CharT* p = data;
+        do
+        {
+            target.push_back(static_cast<typename Container::value_type>(*p++));
+        }
+        while (p != last && p - data < 16 && static_cast<uchar_type>(*p) < 0x80);
+        if (p - data == 16)
+        {
+            const CharT* run_end = jsoncons::detail::find_non_ascii(p, last);
+            append_ascii(p, run_end, target);
+            p = run_end;
+        }
+        return p;
+    }
+
+    // Decodes a UTF-8 sequence already known to be valid, and advances data past it
+
+    template <class CharT>
+    uint32_t decode_valid_utf8(const CharT*& data)
+    {
+        unsigned short extra_bytes_to_read = trailing_bytes_for_utf8[static_cast<uint8_t>(*data)];
+        uint32_t ch = 0;
+        switch (extra_bytes_to_read) 
+        {
+            case 3: ch += static_cast<uint8_t>(*data++); ch <<= 6;
+                JSONCONS_FALLTHROUGH;
+            case 2: ch += static_cast<uint8_t>(*data++); ch <<= 6;
+                JSONCONS_FALLTHROUGH;
+            case 1: ch += static_cast<uint8_t>(*data++); ch <<= 6;
+                JSONCONS_FALLTHROUGH;
+            default: ch += static_cast<uint8_t>(*data++);
+                break;
+        }
+        return ch - offsets_from_utf8[extra_bytes_to_read];
+    }
+
     // convert
 
     template <class CharT>
@@ -593,8 +674,31 @@ namespace jsoncons { namespace unicode_traits {
         conv_errc  result = conv_errc();
 
         const CharT* last = data + length;
+        // Runs of ASCII are copied in bulk, and the prefix that skip_valid_utf8 validates
+        // is decoded without further checks
+        const CharT* valid_end = jsoncons::detail::skip_valid_utf8(data, last);
         while (data != last) 
         {
+            if (static_cast<uint8_t>(*data) < 0x80)
+            {
+                data = append_ascii_run(data, last, target);
+                continue;
+            }
+            if (data < valid_end)
+            {
+                uint32_t ch = decode_valid_utf8(data);
+                if (ch <= max_bmp)
+                {
+                    target.push_back((uint16_t)ch);
+                }
+                else
+                {
+                    ch -= half_base;
+                    target.push_back((uint16_t)((ch >> half_shift) + sur_high_start));
+                    target.push_back((uint16_t)((ch & half_mask) + sur_low_start));
+                }
+                continue;
+            }
             unsigned short extra_bytes_to_read = trailing_bytes_for_utf8[static_cast<uint8_t>(*data)];
             if (extra_bytes_to_read >= last - data) 
             {
@@ -670,8 +774,20 @@ namespace jsoncons { namespace unicode_traits {
         conv_errc  result = conv_errc();
 
         const CharT* last = data + length;
+        // As for UTF-16
+        const CharT* valid_end = jsoncons::detail::skip_valid_utf8(data, last);
         while (data < last) 
         {
+            if (static_cast<uint8_t>(*data) < 0x80)
+            {
+                data = append_ascii_run(data, last, target);
+                continue;
+            }
+            if (data < valid_end)
+            {
+                target.push_back(decode_valid_utf8(data));
+                continue;
+            }
             uint32_t ch = 0;
             unsigned short extra_bytes_to_read = trailing_bytes_for_utf8[static_cast<uint8_t>(*data)];
             if (extra_bytes_to_read >= last - data) 
@@ -754,6 +870,11 @@ namespace jsoncons { namespace unicode_traits {
 
         const CharT* last = data + length;
         while (data < last) {
+            if (static_cast<uint32_t>(*data) < 0x80)
+            {
+                data = append_ascii_run(data, last, target);
+                continue;
+            }
             unsigned short bytes_to_write = 0;
             const uint32_t byteMask = 0xBF;
             const uint32_t byteMark = 0x80; 
@@ -965,6 +1086,11 @@ namespace jsoncons { namespace unicode_traits {
         const CharT* last = data + length;
         while (data < last) 
         {
+            if (static_cast<uint32_t>(*data) < 0x80)
+            {
+                data = append_ascii_run(data, last, target);
+                continue;
+            }
             unsigned short bytes_to_write = 0;
             const uint32_t byteMask = 0xBF;
             const uint32_t byteMark = 0x80; 
@@ -1130,8 +1256,16 @@ namespace jsoncons { namespace unicode_traits {
     {
         conv_errc  result = conv_errc();
         const CharT* last = data + length;
+        // Validates blocks with AVX2 when available, leaving the tail, or the block 
+        // with the first error, to the loop below
+        data = jsoncons::detail::skip_valid_utf8(data, last);
         while (data != last) 
         {
+            if (static_cast<uint8_t>(*data) < 0x80)
+            {
+                data = jsoncons::detail::find_non_ascii(data, last);
+                continue;
+            }
             std::size_t len = static_cast<std::size_t>(trailing_bytes_for_utf8[static_cast<uint8_t>(*data)]) + 1;
             if (len > (std::size_t)(last - data))
             {
@@ -206,6 +206,48 @@ public:
         }
     }
 
+
+    // Skips the remaining elements of the document or array that was begun by the last
+    // event, using its length prefix to ignore them without decoding, then reports its end.
+    void skip_container(json_visitor& visitor, std::error_code& ec)
+    {
+        parse_state& state = state_stack_.back();
+        if (JSONCONS_UNLIKELY(state.length < state.pos + 1))
+        {
+            ec = bson_errc::size_mismatch;
+            more_ = false;
+            return;
+        }
+        std::size_t length = state.length - state.pos - 1;
+        std::size_t start = source_.position();
+        source_.ignore(length);
+        state.pos += source_.position() - start;
+
+        uint8_t type;
+        std::size_t n = source_.read(&type, 1);
+        state.pos += n;
+        if (JSONCONS_UNLIKELY(state.pos != state.length))
+        {
+            ec = bson_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+        if (JSONCONS_UNLIKELY(type != 0x00))
+        {
+            ec = bson_errc::size_mismatch;
+            more_ = false;
+            return;
+        }
+        if (state.mode == parse_mode::array)
+        {
+            end_array(visitor, ec);
+        }
+        else
+        {
+            end_document(visitor, ec);
+        }
+    }
+
 private:
 
     void begin_document(json_visitor& visitor, std::error_code& ec)
@@ -21,6 +21,8 @@
 #include <jsoncons_ext/cbor/cbor_encoder.hpp>
 #include <jsoncons_ext/cbor/encode_cbor.hpp>
 #include <jsoncons_ext/cbor/decode_cbor.hpp>
+#include <jsoncons_ext/cbor/multi_dim_array.hpp>
+#include <jsoncons_ext/cbor/cbor_sequence_writer.hpp>
 
 #endif
 
@@ -198,6 +198,33 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        if (!done() && (cursor_visitor_.event().event_type() == staj_event_type::begin_object || 
+                        cursor_visitor_.event().event_type() == staj_event_type::begin_array))
+        {
+            // Typed arrays have already been read, and some arrays and maps must be decoded
+            parser_.restart();
+            if (cursor_visitor_.in_available() || !parser_.skip_container(cursor_handler_adaptor_, ec))
+            {
+                basic_staj_cursor<char_type>::skip(ec);
+                return;
+            }
+            if (ec) return;
+        }
+        read_next(ec);
+    }
+
     const ser_context& context() const override
     {
         return *this;
@@ -12,7 +12,8 @@
 #include <memory>
 #include <iterator> // std::forward_iterator_tag
 #include <limits> // std::numeric_limits
-#include <utility> // std::move
+#include <utility> // std::move, std::pair
+#include <cstring> // std::memcmp, std::memcpy
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
@@ -88,6 +89,129 @@ size_t min_length_for_stringref(uint64_t index)
     return n;
 }
 
+// stringref_table
+//
+// The strings an encoder with pack_strings set has assigned stringref indexes to.
+// Keys are copied into one growing byte arena, and found through an open addressing
+// index that holds entry positions plus one, zero marking an empty slot. A lookup
+// hashes and compares the candidate bytes where they are, without a temporary copy.
+
+template <class Allocator>
+class stringref_table
+{
+    struct entry
+    {
+        std::size_t offset;
+        std::size_t length;
+        uint64_t index;
+        uint32_t hash;
+    };
+
+    using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t>;
+    using entry_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<entry>;
+    using slot_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<std::size_t>;
+
+    std::vector<uint8_t,byte_allocator_type> arena_;
+    std::vector<entry,entry_allocator_type> entries_;
+    std::vector<std::size_t,slot_allocator_type> slots_;
+public:
+    explicit stringref_table(const Allocator& alloc)
+        : arena_(alloc), entries_(alloc), slots_(alloc)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return entries_.size();
+    }
+
+    void clear()
+    {
+        arena_.clear();
+        entries_.clear();
+        slots_.clear();
+    }
+
+    // If the string [data,data+length) is in the table, returns its index and false,
+    // otherwise adds it with the given index and returns that index and true
+    std::pair<uint64_t,bool> insert(const uint8_t* data, std::size_t length, uint64_t index)
+    {
+        uint32_t h = hash_bytes(data, length);
+        if (!slots_.empty())
+        {
+            std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = h & mask; slots_[i] != 0; i = (i + 1) & mask)
+            {
+                const entry& e = entries_[slots_[i] - 1];
+                if (e.hash == h && e.length == length && std::memcmp(arena_.data() + e.offset, data, length) == 0)
+                {
+                    return std::pair<uint64_t,bool>(e.index, false);
+                }
+            }
+        }
+
+        entry e;
+        e.offset = arena_.size();
+        e.length = length;
+        e.index = index;
+        e.hash = h;
+        arena_.insert(arena_.end(), data, data + length);
+        entries_.push_back(e);
+        if (slots_.size() * 3 < entries_.size() * 4)
+        {
+            rehash(slots_.empty() ? 64 : slots_.size() * 2);
+        }
+        else
+        {
+            place(entries_.size());
+        }
+        return std::pair<uint64_t,bool>(index, true);
+    }
+
+private:
+    void place(std::size_t slot_value)
+    {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = entries_[slot_value - 1].hash & mask;
+        while (slots_[i] != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot_value;
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        slots_.assign(capacity, 0);
+        for (std::size_t k = 1; k <= entries_.size(); ++k)
+        {
+            place(k);
+        }
+    }
+
+    // Reads eight bytes at a time
+    static uint32_t hash_bytes(const uint8_t* data, std::size_t length)
+    {
+        uint64_t h = 0x9e3779b97f4a7c15ULL ^ length;
+        while (length >= 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, data, 8);
+            h = (h ^ w) * 0xff51afd7ed558ccdULL;
+            h ^= h >> 32;
+            data += 8;
+            length -= 8;
+        }
+        uint64_t w = 0;
+        std::memcpy(&w, data, length);
+        h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<uint32_t>(h >> 32);
+    }
+};
+
 }}}
 
 #endif
@@ -81,8 +81,6 @@ private:
 
     };
 
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,size_t>> string_size_allocator_type;
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const byte_string_type,size_t>> byte_string_size_allocator_type;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
 
     Sink sink_;
@@ -90,8 +88,8 @@ private:
     allocator_type alloc_;
 
     std::vector<stack_item,stack_item_allocator_type> stack_;
-    std::map<string_type,size_t,std::less<string_type>,string_size_allocator_type> stringref_map_;
-    std::map<byte_string_type,size_t,std::less<byte_string_type>,byte_string_size_allocator_type> bytestringref_map_;
+    jsoncons::cbor::detail::stringref_table<allocator_type> stringref_map_;
+    jsoncons::cbor::detail::stringref_table<allocator_type> bytestringref_map_;
     std::size_t next_stringref_ = 0;
     int nesting_depth_;
 
@@ -111,10 +109,8 @@ public:
          options_(options), 
          alloc_(alloc),
          stack_(alloc),
-#if !defined(JSONCONS_NO_MAP_CONS_TAKES_ALLOCATOR) 
          stringref_map_(alloc),
          bytestringref_map_(alloc),
-#endif 
          nesting_depth_(0)        
     {
         if (options.pack_strings())
@@ -141,6 +137,10 @@ public:
         bytestringref_map_.clear();
         next_stringref_ = 0;
         nesting_depth_ = 0;
+        if (options_.pack_strings())
+        {
+            write_tag(256);
+        }
     }
 
     void reset(Sink&& sink)
@@ -361,17 +361,16 @@ private:
 
         if (options_.pack_strings() && sv.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
         {
-            string_type s(sv.data(), sv.size(), alloc_);
-            auto it = stringref_map_.find(s);
-            if (it == stringref_map_.end())
+            auto result = stringref_map_.insert(reinterpret_cast<const uint8_t*>(sv.data()), sv.size(), next_stringref_);
+            if (result.second)
             {
-                stringref_map_.emplace(std::make_pair(std::move(s), next_stringref_++));
+                ++next_stringref_;
                 write_utf8_string(sv);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(result.first);
             }
         }
         else
@@ -912,17 +911,16 @@ private:
         }
         if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            auto result = bytestringref_map_.insert(b.data(), b.size(), next_stringref_);
+            if (result.second)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
-                write_byte_string_value(bs);
+                ++next_stringref_;
+                write_byte_string_value(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(result.first);
             }
         }
         else
@@ -941,18 +939,17 @@ private:
     {
         if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            auto result = bytestringref_map_.insert(b.data(), b.size(), next_stringref_);
+            if (result.second)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
+                ++next_stringref_;
                 write_tag(ext_tag);
-                write_byte_string_value(bs);
+                write_byte_string_value(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(result.first);
             }
         }
         else
@@ -1264,6 +1261,7 @@ private:
                     break;
             }
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1294,6 +1292,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1324,6 +1323,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1354,6 +1354,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1382,6 +1383,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int8_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int8_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1412,6 +1414,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int16_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1442,6 +1445,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1472,6 +1476,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1502,6 +1507,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1532,6 +1538,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(float));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(float));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1562,6 +1569,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(double));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(double));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
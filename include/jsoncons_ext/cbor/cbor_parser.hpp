@@ -12,10 +12,12 @@
 #include <memory>
 #include <utility> // std::move
 #include <bitset> // std::bitset
+#include <cstring> // std::memcpy
 #include <jsoncons/json.hpp>
 #include <jsoncons/source.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/simd.hpp>
 #include <jsoncons_ext/cbor/cbor_error.hpp>
 #include <jsoncons_ext/cbor/cbor_detail.hpp>
 #include <jsoncons_ext/cbor/cbor_options.hpp>
@@ -132,6 +134,12 @@ class basic_cbor_parser : public ser_context
                 c.push_back(b);
             }
         }
+
+        bool in_place(jsoncons::span<const uint8_t>& s, std::error_code&)
+        {
+            s = jsoncons::span<const uint8_t>(bytes.data(), bytes.size());
+            return true;
+        }
     };
 
     struct read_byte_string_from_source
@@ -147,6 +155,11 @@ class basic_cbor_parser : public ser_context
         {
             source->read_byte_string(c,ec);
         }
+
+        bool in_place(jsoncons::span<const uint8_t>& s, std::error_code& ec)
+        {
+            return source->read_byte_string_in_place(s,ec);
+        }
     };
 
 public:
@@ -334,7 +347,193 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the array or map that was begun by the last event,
+    // following the length prefixes without decoding the items, then reports its end.
+    // Returns false, and consumes nothing, if the items must be decoded, that is,
+    // inside a stringref namespace or a multi-dimensional array.
+    bool skip_container(json_visitor2& visitor, std::error_code& ec)
+    {
+        if (!stringref_map_stack_.empty())
+        {
+            return false;
+        }
+
+        std::vector<uint64_t> counts;
+        bool is_array = true;
+        switch (state_stack_.back().mode)
+        {
+            case parse_mode::array:
+                counts.push_back(state_stack_.back().length - state_stack_.back().index);
+                break;
+            case parse_mode::indefinite_array:
+                counts.push_back(indefinite_count);
+                break;
+            case parse_mode::map_key:
+                counts.push_back(2*(state_stack_.back().length - state_stack_.back().index));
+                is_array = false;
+                break;
+            case parse_mode::indefinite_map_key:
+                counts.push_back(indefinite_count);
+                is_array = false;
+                break;
+            default:
+                return false;
+        }
+
+        skip_items(counts, ec);
+        if (ec)
+        {
+            more_ = false;
+            return true;
+        }
+
+        if (is_array)
+        {
+            end_array(visitor, ec);
+        }
+        else
+        {
+            end_object(visitor, ec);
+        }
+        return true;
+    }
+
+    // Skips the data item at the current position of the source, following the length
+    // prefixes without decoding it. Used to find the item boundaries of a CBOR sequence.
+    void skip_item(std::error_code& ec)
+    {
+        std::vector<uint64_t> counts;
+        counts.push_back(1);
+        skip_items(counts, ec);
+    }
 private:
+    static constexpr uint64_t indefinite_count = (std::numeric_limits<uint64_t>::max)();
+
+    void skip_items(std::vector<uint64_t>& counts, std::error_code& ec)
+    {
+        while (!counts.empty())
+        {
+            if (counts.back() == indefinite_count)
+            {
+                auto c = source_.peek();
+                if (c.eof)
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    return;
+                }
+                if (c.value == 0xff)
+                {
+                    source_.ignore(1);
+                    counts.pop_back();
+                    continue;
+                }
+            }
+            else if (counts.back() == 0)
+            {
+                counts.pop_back();
+                continue;
+            }
+            else
+            {
+                --counts.back();
+            }
+            skip_data_item_head(counts, ec);
+            if (ec)
+            {
+                return;
+            }
+        }
+    }
+
+    // Consumes the head of a data item and the content of a definite length string, 
+    // and pushes the number of nested items of an array or map
+    void skip_data_item_head(std::vector<uint64_t>& counts, std::error_code& ec)
+    {
+        uint8_t b;
+        if (source_.read(&b, 1) == 0)
+        {
+            ec = cbor_errc::unexpected_eof;
+            return;
+        }
+        jsoncons::cbor::detail::cbor_major_type major_type = get_major_type(b);
+        uint8_t info = get_additional_information_value(b);
+
+        uint64_t val = info;
+        bool indefinite = false;
+        switch (info)
+        {
+            case 0x18:
+            case 0x19:
+            case 0x1a:
+            case 0x1b:
+            {
+                uint8_t buf[sizeof(uint64_t)];
+                std::size_t n = std::size_t(1) << (info - 0x18);
+                if (source_.read(buf, n) != n)
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    return;
+                }
+                val = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    val = (val << 8) | buf[i];
+                }
+                break;
+            }
+            case 0x1c:
+            case 0x1d:
+            case 0x1e:
+                ec = cbor_errc::unknown_type;
+                return;
+            case 0x1f:
+                indefinite = true;
+                break;
+            default:
+                break;
+        }
+
+        switch (major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::byte_string:
+            case jsoncons::cbor::detail::cbor_major_type::text_string:
+                if (indefinite)
+                {
+                    counts.push_back(indefinite_count);
+                }
+                else
+                {
+                    std::size_t pos = source_.position();
+                    source_.ignore(static_cast<std::size_t>(val));
+                    if (source_.position() - pos != val)
+                    {
+                        ec = cbor_errc::unexpected_eof;
+                    }
+                }
+                break;
+            case jsoncons::cbor::detail::cbor_major_type::array:
+                counts.push_back(indefinite ? indefinite_count : val);
+                break;
+            case jsoncons::cbor::detail::cbor_major_type::map:
+                counts.push_back(indefinite ? indefinite_count : 2*val);
+                break;
+            case jsoncons::cbor::detail::cbor_major_type::semantic_tag:
+                // The tagged item follows
+                if (counts.back() != indefinite_count)
+                {
+                    ++counts.back();
+                }
+                break;
+            default:
+                if (indefinite)
+                {
+                    ec = cbor_errc::unknown_type;
+                }
+                break;
+        }
+    }
+
     void read_item(json_visitor2& visitor, std::error_code& ec)
     {
         read_tags(ec);
@@ -792,6 +991,44 @@ private:
         return more;
     }
 
+    // Views a definite length byte string in the input, if the source is contiguous. 
+    // Returns false, having consumed nothing, if the byte string has to be copied.
+    template <class S = Source>
+    typename std::enable_if<is_contiguous_source<S>::value && std::is_same<typename S::value_type,uint8_t>::value,bool>::type
+    read_byte_string_in_place(jsoncons::span<const uint8_t>& bytes, std::error_code& ec)
+    {
+        auto c = source_.peek();
+        if (c.eof || get_additional_information_value(c.value) == jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            return false;
+        }
+        std::size_t length = get_size(ec);
+        if (ec)
+        {
+            return true;
+        }
+        bytes = source_.read_span(length);
+        if (bytes.size() != length)
+        {
+            ec = cbor_errc::unexpected_eof;
+            more_ = false;
+            return true;
+        }
+        if (!stringref_map_stack_.empty() &&
+            length >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_stack_.back().size()))
+        {
+            stringref_map_stack_.back().emplace_back(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+        }
+        return true;
+    }
+
+    template <class S = Source>
+    typename std::enable_if<!(is_contiguous_source<S>::value && std::is_same<typename S::value_type,uint8_t>::value),bool>::type
+    read_byte_string_in_place(jsoncons::span<const uint8_t>&, std::error_code&)
+    {
+        return false;
+    }
+
     template <class Function>
     void iterate_string_chunks(Function& func, jsoncons::cbor::detail::cbor_major_type type, std::error_code& ec)
     {
@@ -1478,6 +1715,52 @@ private:
         return std::size_t(1) << (f + ll); 
     }
 
+    // Returns the elements of a typed array. If the payload can be viewed in place and 
+    // is in host byte order and suitably aligned, the result refers to it directly, 
+    // otherwise the payload is copied to typed_array_, byte swapped if need be.
+    template <class T, class Read>
+    jsoncons::span<const T> read_typed_array(Read& read, std::error_code& ec)
+    {
+        const uint8_t tag = (uint8_t)item_tag_;
+        const bool swap = sizeof(T) > 1 && get_typed_array_endianness(tag) != jsoncons::endian::native;
+
+        jsoncons::span<const uint8_t> bytes;
+        if (read.in_place(bytes, ec))
+        {
+            if (ec)
+            {
+                return jsoncons::span<const T>();
+            }
+            if (!swap && reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) == 0)
+            {
+                return jsoncons::span<const T>(reinterpret_cast<const T*>(bytes.data()), bytes.size()/sizeof(T));
+            }
+            typed_array_.resize(bytes.size());
+            if (swap)
+            {
+                jsoncons::detail::byte_swap_copy(bytes.data(), bytes.size()/sizeof(T), sizeof(T), typed_array_.data());
+            }
+            else if (!bytes.empty())
+            {
+                std::memcpy(typed_array_.data(), bytes.data(), bytes.size());
+            }
+        }
+        else
+        {
+            typed_array_.clear();
+            read(typed_array_,ec);
+            if (ec)
+            {
+                return jsoncons::span<const T>();
+            }
+            if (swap)
+            {
+                jsoncons::detail::byte_swap_copy(typed_array_.data(), typed_array_.size()/sizeof(T), sizeof(T), typed_array_.data());
+            }
+        }
+        return jsoncons::span<const T>(reinterpret_cast<const T*>(typed_array_.data()), typed_array_.size()/sizeof(T));
+    }
+
     template <typename Read>
     void write_byte_string(Read read, json_visitor2& visitor, std::error_code& ec)
     {
@@ -1551,280 +1834,143 @@ private:
                 }
                 case 0x40:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint8_t> data = read_typed_array<uint8_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    uint8_t* data = reinterpret_cast<uint8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    more_ = visitor.typed_array(jsoncons::span<const uint8_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x44:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint8_t> data = read_typed_array<uint8_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    uint8_t* data = reinterpret_cast<uint8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    more_ = visitor.typed_array(jsoncons::span<const uint8_t>(data,size), semantic_tag::clamped, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::clamped, *this, ec);
                     break;
                 }
                 case 0x41:
                 case 0x45:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint16_t> data = read_typed_array<uint16_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint16_t* data = reinterpret_cast<uint16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint16_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const uint16_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x42:
                 case 0x46:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint32_t> data = read_typed_array<uint32_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag);
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint32_t* data = reinterpret_cast<uint32_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint32_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const uint32_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x43:
                 case 0x47:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint64_t> data = read_typed_array<uint64_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint64_t* data = reinterpret_cast<uint64_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint64_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const uint64_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x48:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const int8_t> data = read_typed_array<int8_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    int8_t* data = reinterpret_cast<int8_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size();
-                    more_ = visitor.typed_array(jsoncons::span<const int8_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x49:
                 case 0x4d:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const int16_t> data = read_typed_array<int16_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int16_t* data = reinterpret_cast<int16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int16_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const int16_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x4a:
                 case 0x4e:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const int32_t> data = read_typed_array<int32_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int32_t* data = reinterpret_cast<int32_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int32_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const int32_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x4b:
                 case 0x4f:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const int64_t> data = read_typed_array<int64_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    int64_t* data = reinterpret_cast<int64_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<int64_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const int64_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x50:
                 case 0x54:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const uint16_t> data = read_typed_array<uint16_t>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    uint16_t* data = reinterpret_cast<uint16_t*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<uint16_t>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(half_arg, jsoncons::span<const uint16_t>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(half_arg, data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x51:
                 case 0x55:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const float> data = read_typed_array<float>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    float* data = reinterpret_cast<float*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<float>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const float>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 case 0x52:
                 case 0x56:
                 {
-                    typed_array_.clear();
-                    read(typed_array_,ec);
+                    jsoncons::span<const double> data = read_typed_array<double>(read, ec);
                     if (ec)
                     {
                         more_ = false;
                         return;
                     }
-                    const uint8_t tag = (uint8_t)item_tag_;
-                    jsoncons::endian e = get_typed_array_endianness(tag); 
-                    const size_t bytes_per_elem = get_typed_array_bytes_per_element(tag);
-
-                    double* data = reinterpret_cast<double*>(typed_array_.data());
-                    std::size_t size = typed_array_.size()/bytes_per_elem;
-
-                    if (e != jsoncons::endian::native)
-                    {
-                        for (std::size_t i = 0; i < size; ++i)
-                        {
-                            data[i] = binary::byte_swap<double>(data[i]);
-                        }
-                    }
-                    more_ = visitor.typed_array(jsoncons::span<const double>(data,size), semantic_tag::none, *this, ec);
+                    more_ = visitor.typed_array(data, semantic_tag::none, *this, ec);
                     break;
                 }
                 default:
@@ -1937,6 +2083,9 @@ private:
     }
 };
 
+template <class Source,class Allocator>
+constexpr uint64_t basic_cbor_parser<Source,Allocator>::indefinite_count;
+
 }}
 
 #endif
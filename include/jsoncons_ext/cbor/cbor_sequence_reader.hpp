@@ -0,0 +1,597 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_SEQUENCE_READER_HPP
+#define JSONCONS_CBOR_CBOR_SEQUENCE_READER_HPP
+
+#include <memory> // std::allocator
+#include <vector>
+#include <map>
+#include <deque>
+#include <istream>
+#include <type_traits> // std::enable_if
+#include <system_error>
+#include <exception> // std::exception_ptr
+#include <utility> // std::move
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/decode_traits.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/cbor/cbor_parser.hpp>
+#include <jsoncons_ext/cbor/cbor_cursor.hpp>
+
+namespace jsoncons {
+namespace cbor {
+
+namespace detail {
+
+    // Decodes the items of a CBOR sequence into a T through decode_traits
+    template <class T,class TempAllocator,class Enable=void>
+    class cbor_item_decoder
+    {
+        std::error_code init_ec_;
+        basic_cbor_cursor<bytes_source,TempAllocator> cursor_;
+        json_decoder<basic_json<char,sorted_policy,TempAllocator>,TempAllocator> decoder_;
+    public:
+        cbor_item_decoder(const cbor_decode_options& options, const TempAllocator& alloc)
+            : cursor_(std::allocator_arg, alloc, bytes_source(), options, init_ec_),
+              decoder_(result_allocator_arg, alloc, alloc)
+        {
+        }
+
+        T decode(const uint8_t* data, std::size_t length, std::error_code& ec)
+        {
+            cursor_.reset(jsoncons::span<const uint8_t>(data, length), ec);
+            if (ec)
+            {
+                return T();
+            }
+            return decode_traits<T,char>::decode(cursor_, decoder_, ec);
+        }
+
+        // The offset in the item of the last byte read
+        std::size_t position() const
+        {
+            return cursor_.context().column();
+        }
+    };
+
+    // Decodes the items of a CBOR sequence into a basic_json, without a cursor
+    template <class T,class TempAllocator>
+    class cbor_item_decoder<T,TempAllocator,
+        typename std::enable_if<type_traits::is_basic_json<T>::value &&
+                                std::is_same<typename T::char_type,char>::value
+    >::type>
+    {
+        json_decoder<T,TempAllocator> decoder_;
+        basic_json_visitor2_to_visitor_adaptor<char,TempAllocator> adaptor_;
+        basic_cbor_parser<bytes_source,TempAllocator> parser_;
+    public:
+        cbor_item_decoder(const cbor_decode_options& options, const TempAllocator& alloc)
+            : decoder_(alloc), adaptor_(decoder_, alloc), parser_(bytes_source(), options, alloc)
+        {
+        }
+
+        T decode(const uint8_t* data, std::size_t length, std::error_code& ec)
+        {
+            decoder_.reset();
+            adaptor_.reset();
+            parser_.reset(jsoncons::span<const uint8_t>(data, length));
+            parser_.parse(adaptor_, ec);
+            if (!ec && !decoder_.is_valid())
+            {
+                ec = conv_errc::conversion_failed;
+            }
+            return ec ? T() : decoder_.get_result();
+        }
+
+        std::size_t position() const
+        {
+            return parser_.column();
+        }
+    };
+
+} // namespace detail
+
+    // cbor_sequence_reader
+    // Reads a CBOR sequence (RFC 8742), data items concatenated with no enclosing array.
+    // The calling thread finds the item boundaries by following the length prefixes,
+    // without decoding, and hands chunks of whole items to a pool of worker threads,
+    // each with its own parser. Values are always passed to the callback on the calling thread.
+
+    template <class T,class TempAllocator=std::allocator<char>>
+    class cbor_sequence_reader
+    {
+    public:
+        using value_type = T;
+    private:
+        static constexpr std::size_t default_chunk_size = 1024*1024;
+
+        struct item_chunk
+        {
+            std::size_t index;
+            std::size_t first_item;
+            // The offset of the chunk in the input
+            std::size_t offset;
+            // Points into the input when reading from memory, otherwise the bytes are in storage
+            const uint8_t* data;
+            std::vector<uint8_t> storage;
+            // The end of each item, relative to the start of the chunk
+            std::vector<std::size_t> ends;
+            // A malformed or truncated item that follows the last item
+            std::error_code ec;
+            std::size_t error_position;
+
+            item_chunk()
+                : index(0), first_item(0), offset(0), data(nullptr), error_position(0)
+            {
+            }
+
+            const uint8_t* bytes() const
+            {
+                return data != nullptr ? data : storage.data();
+            }
+        };
+
+        struct item_record
+        {
+            std::size_t index;
+            T value;
+        };
+
+        struct chunk_result
+        {
+            std::size_t index;
+            std::vector<item_record> records;
+            std::error_code ec;
+            std::size_t position;
+            std::exception_ptr eptr;
+
+            explicit chunk_result(std::size_t index)
+                : index(index), position(0)
+            {
+            }
+        };
+
+        class worker_state
+        {
+            detail::cbor_item_decoder<T,TempAllocator> decoder_;
+        public:
+            worker_state(const cbor_decode_options& options, const TempAllocator& alloc)
+                : decoder_(options, alloc)
+            {
+            }
+
+            void parse(const item_chunk& chunk, chunk_result& result)
+            {
+                const uint8_t* data = chunk.bytes();
+                std::size_t begin = 0;
+                for (std::size_t i = 0; i < chunk.ends.size(); ++i)
+                {
+                    std::error_code ec;
+                    T value = decoder_.decode(data + begin, chunk.ends[i] - begin, ec);
+                    if (ec)
+                    {
+                        result.ec = ec;
+                        result.position = chunk.offset + begin + decoder_.position();
+                        return;
+                    }
+                    result.records.push_back(item_record{chunk.first_item + i, std::move(value)});
+                    begin = chunk.ends[i];
+                }
+                if (chunk.ec)
+                {
+                    result.ec = chunk.ec;
+                    result.position = chunk.error_position;
+                }
+            }
+        };
+
+        const uint8_t* input_;
+        std::size_t length_;
+        std::istream* is_;
+        cbor_decode_options options_;
+        TempAllocator alloc_;
+        std::size_t num_threads_;
+        std::size_t chunk_size_;
+        bool preserve_order_;
+
+        // Finds the item boundaries
+        basic_cbor_parser<bytes_source,TempAllocator> scanner_;
+        std::size_t offset_;
+        std::size_t next_item_;
+        std::size_t next_index_;
+        std::vector<uint8_t> carry_;
+        bool scan_done_;
+        std::size_t position_;
+
+        // Shared with the workers
+        std::mutex mutex_;
+        std::condition_variable work_available_;
+        std::condition_variable result_available_;
+        std::deque<item_chunk> work_;
+        std::deque<chunk_result> results_;
+        bool stopping_;
+
+        // noncopyable and nonmoveable
+        cbor_sequence_reader(const cbor_sequence_reader&) = delete;
+        cbor_sequence_reader& operator=(const cbor_sequence_reader&) = delete;
+
+    public:
+        template <class Source>
+        explicit cbor_sequence_reader(const Source& source,
+                                      const cbor_decode_options& options = cbor_decode_options(),
+                                      const TempAllocator& alloc = TempAllocator(),
+                                      typename std::enable_if<type_traits::is_byte_sequence<Source>::value,int>::type = 0)
+            : input_(reinterpret_cast<const uint8_t*>(source.data())), length_(source.size()), is_(nullptr),
+              options_(options), alloc_(alloc),
+              num_threads_(std::thread::hardware_concurrency()), chunk_size_(default_chunk_size), preserve_order_(true),
+              scanner_(bytes_source(), options, alloc),
+              offset_(0), next_item_(0), next_index_(0), scan_done_(false), position_(0), stopping_(false)
+        {
+        }
+
+        explicit cbor_sequence_reader(std::istream& is,
+                                      const cbor_decode_options& options = cbor_decode_options(),
+                                      const TempAllocator& alloc = TempAllocator())
+            : input_(nullptr), length_(0), is_(std::addressof(is)),
+              options_(options), alloc_(alloc),
+              num_threads_(std::thread::hardware_concurrency()), chunk_size_(default_chunk_size), preserve_order_(true),
+              scanner_(bytes_source(), options, alloc),
+              offset_(0), next_item_(0), next_index_(0), scan_done_(false), position_(0), stopping_(false)
+        {
+        }
+
+        // The number of worker threads, 0 or 1 decodes on the calling thread.
+        // The default is std::thread::hardware_concurrency()
+        cbor_sequence_reader& num_threads(std::size_t value)
+        {
+            num_threads_ = value;
+            return *this;
+        }
+
+        // The approximate size of the chunks handed to the workers, in bytes
+        cbor_sequence_reader& chunk_size(std::size_t value)
+        {
+            chunk_size_ = value > 0 ? value : 1;
+            return *this;
+        }
+
+        // If true, values are passed to the callback in input order, otherwise
+        // each chunk's values are passed as soon as the chunk is decoded
+        cbor_sequence_reader& preserve_order(bool value)
+        {
+            preserve_order_ = value;
+            return *this;
+        }
+
+        // The offset in the input of the error that stopped reading
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        // Calls f(T&& value, std::size_t index) for each item, returns the number of values read
+        template <class F>
+        std::size_t read(F f)
+        {
+            std::error_code ec;
+            std::size_t count = read(f, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,position_));
+            }
+            return count;
+        }
+
+        template <class F>
+        std::size_t read(F f, std::error_code& ec)
+        {
+            if (num_threads_ <= 1)
+            {
+                return read_sequential(f, ec);
+            }
+
+            std::vector<std::thread> workers;
+            thread_guard guard(*this, workers);
+            for (std::size_t i = 0; i < num_threads_; ++i)
+            {
+                workers.emplace_back([this](){run_worker();});
+            }
+
+            // At most this many chunks are decoded but not yet passed on
+            const std::size_t max_in_flight = 2 * num_threads_;
+            std::size_t in_flight = 0;
+            std::size_t next_to_deliver = 0;
+            std::map<std::size_t,chunk_result> pending;
+            std::size_t count = 0;
+            bool more_input = true;
+
+            while (true)
+            {
+                while (more_input && in_flight < max_in_flight)
+                {
+                    item_chunk chunk;
+                    more_input = next_chunk(chunk);
+                    if (more_input)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            work_.push_back(std::move(chunk));
+                        }
+                        work_available_.notify_one();
+                        ++in_flight;
+                    }
+                }
+                if (in_flight == 0)
+                {
+                    break;
+                }
+
+                std::deque<chunk_result> ready;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    result_available_.wait(lock, [this](){return !results_.empty();});
+                    ready.swap(results_);
+                }
+                for (auto& result : ready)
+                {
+                    if (preserve_order_)
+                    {
+                        pending.emplace(result.index, std::move(result));
+                    }
+                    else
+                    {
+                        --in_flight;
+                        if (!deliver(result, f, count, ec))
+                        {
+                            return count;
+                        }
+                    }
+                }
+                if (preserve_order_)
+                {
+                    auto it = pending.find(next_to_deliver);
+                    while (it != pending.end())
+                    {
+                        --in_flight;
+                        ++next_to_deliver;
+                        if (!deliver(it->second, f, count, ec))
+                        {
+                            return count;
+                        }
+                        pending.erase(it);
+                        it = pending.find(next_to_deliver);
+                    }
+                }
+            }
+            return count;
+        }
+
+    private:
+
+        // Stops and joins the workers, also when the callback throws
+        class thread_guard
+        {
+            cbor_sequence_reader& reader_;
+            std::vector<std::thread>& workers_;
+        public:
+            thread_guard(cbor_sequence_reader& reader, std::vector<std::thread>& workers)
+                : reader_(reader), workers_(workers)
+            {
+                reader_.stopping_ = false;
+            }
+
+            thread_guard(const thread_guard&) = delete;
+            thread_guard& operator=(const thread_guard&) = delete;
+
+            ~thread_guard()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(reader_.mutex_);
+                    reader_.stopping_ = true;
+                    reader_.work_.clear();
+                }
+                reader_.work_available_.notify_all();
+                for (auto& worker : workers_)
+                {
+                    worker.join();
+                }
+                reader_.results_.clear();
+            }
+        };
+
+        void run_worker()
+        {
+            worker_state state(options_, alloc_);
+            while (true)
+            {
+                item_chunk chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    work_available_.wait(lock, [this](){return stopping_ || !work_.empty();});
+                    if (stopping_)
+                    {
+                        return;
+                    }
+                    chunk = std::move(work_.front());
+                    work_.pop_front();
+                }
+                chunk_result result(chunk.index);
+                JSONCONS_TRY
+                {
+                    state.parse(chunk, result);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    result.eptr = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    results_.push_back(std::move(result));
+                }
+                result_available_.notify_one();
+            }
+        }
+
+        template <class F>
+        std::size_t read_sequential(F f, std::error_code& ec)
+        {
+            worker_state state(options_, alloc_);
+            std::size_t count = 0;
+            item_chunk chunk;
+            while (next_chunk(chunk))
+            {
+                chunk_result result(chunk.index);
+                state.parse(chunk, result);
+                if (!deliver(result, f, count, ec))
+                {
+                    break;
+                }
+            }
+            return count;
+        }
+
+        template <class F>
+        bool deliver(chunk_result& result, F& f, std::size_t& count, std::error_code& ec)
+        {
+            if (result.eptr)
+            {
+                std::rethrow_exception(result.eptr);
+            }
+            for (auto& record : result.records)
+            {
+                f(std::move(record.value), record.index);
+                ++count;
+            }
+            if (result.ec)
+            {
+                ec = result.ec;
+                position_ = result.position;
+                return false;
+            }
+            return true;
+        }
+
+        // Takes the next chunk of whole items, returns false at the end
+        bool next_chunk(item_chunk& chunk)
+        {
+            chunk.index = next_index_;
+            chunk.first_item = next_item_;
+            chunk.offset = offset_;
+            chunk.ends.clear();
+            chunk.ec = std::error_code();
+            chunk.error_position = 0;
+            if (scan_done_)
+            {
+                return false;
+            }
+
+            std::error_code ec;
+            if (is_ == nullptr)
+            {
+                if (offset_ >= length_)
+                {
+                    return false;
+                }
+                chunk.data = input_ + offset_;
+                scan(chunk, length_ - offset_, ec);
+                if (ec)
+                {
+                    chunk.ec = ec;
+                    chunk.error_position = offset_ + scanner_.column();
+                    scan_done_ = true;
+                }
+                else
+                {
+                    offset_ += chunk.ends.back();
+                }
+            }
+            else
+            {
+                chunk.data = nullptr;
+                chunk.storage.clear();
+                chunk.storage.swap(carry_);
+                // Grows until the chunk holds at least one whole item
+                std::size_t read_size = chunk_size_;
+                while (true)
+                {
+                    bool more = read_more(chunk.storage, read_size);
+                    if (chunk.storage.empty())
+                    {
+                        return false;
+                    }
+                    chunk.ends.clear();
+                    ec = std::error_code();
+                    scan(chunk, chunk.storage.size(), ec);
+                    if (ec == cbor_errc::unexpected_eof && more && chunk.ends.empty())
+                    {
+                        read_size = chunk.storage.size();
+                        continue;
+                    }
+                    if (ec && !(ec == cbor_errc::unexpected_eof && more))
+                    {
+                        chunk.ec = ec;
+                        chunk.error_position = offset_ + scanner_.column();
+                        scan_done_ = true;
+                    }
+                    else
+                    {
+                        std::size_t end = chunk.ends.back();
+                        carry_.assign(chunk.storage.begin() + end, chunk.storage.end());
+                        chunk.storage.resize(end);
+                        offset_ += end;
+                    }
+                    break;
+                }
+            }
+            next_item_ += chunk.ends.size();
+            ++next_index_;
+            return true;
+        }
+
+        // Follows the length prefixes of the items until the chunk size is reached
+        void scan(item_chunk& chunk, std::size_t length, std::error_code& ec)
+        {
+            scanner_.reset(jsoncons::span<const uint8_t>(chunk.bytes(), length));
+            std::size_t end = 0;
+            while (end < length && end < chunk_size_)
+            {
+                scanner_.skip_item(ec);
+                if (ec)
+                {
+                    return;
+                }
+                end = scanner_.column();
+                chunk.ends.push_back(end);
+            }
+        }
+
+        // Appends up to n bytes from the stream, returns false if the stream is exhausted
+        bool read_more(std::vector<uint8_t>& buffer, std::size_t n)
+        {
+            if (!*is_)
+            {
+                return false;
+            }
+            std::size_t offset = buffer.size();
+            buffer.resize(offset + n);
+            is_->read(reinterpret_cast<char*>(buffer.data() + offset), static_cast<std::streamsize>(n));
+            buffer.resize(offset + static_cast<std::size_t>(is_->gcount()));
+            return static_cast<bool>(*is_);
+        }
+    };
+
+    template <class T,class TempAllocator>
+    constexpr std::size_t cbor_sequence_reader<T,TempAllocator>::default_chunk_size;
+
+} // namespace cbor
+} // namespace jsoncons
+
+#endif
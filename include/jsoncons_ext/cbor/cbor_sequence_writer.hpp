@@ -0,0 +1,106 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_SEQUENCE_WRITER_HPP
+#define JSONCONS_CBOR_CBOR_SEQUENCE_WRITER_HPP
+
+#include <memory> // std::allocator
+#include <vector>
+#include <type_traits> // std::enable_if
+#include <system_error>
+#include <jsoncons/json.hpp>
+#include <jsoncons/encode_traits.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons_ext/cbor/cbor_encoder.hpp>
+
+namespace jsoncons {
+namespace cbor {
+
+    // basic_cbor_sequence_writer
+    // Writes a CBOR sequence (RFC 8742), data items concatenated with no enclosing array.
+    // Each item is self contained, in particular it has its own stringref namespace
+    // when strings are packed.
+
+    template<class Sink=jsoncons::binary_stream_sink,class Allocator=std::allocator<char>>
+    class basic_cbor_sequence_writer
+    {
+    public:
+        using sink_type = Sink;
+        using allocator_type = Allocator;
+    private:
+        basic_cbor_encoder<Sink,Allocator> encoder_;
+        std::size_t count_;
+
+        // noncopyable and nonmoveable
+        basic_cbor_sequence_writer(const basic_cbor_sequence_writer&) = delete;
+        basic_cbor_sequence_writer& operator=(const basic_cbor_sequence_writer&) = delete;
+    public:
+        explicit basic_cbor_sequence_writer(Sink&& sink,
+                                            const cbor_encode_options& options = cbor_encode_options(),
+                                            const Allocator& alloc = Allocator())
+            : encoder_(std::forward<Sink>(sink), options, alloc), count_(0)
+        {
+        }
+
+        // The number of items written
+        std::size_t size() const
+        {
+            return count_;
+        }
+
+        template <class T>
+        void write(const T& val)
+        {
+            std::error_code ec;
+            write(val, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<type_traits::is_basic_json<T>::value>::type
+        write(const T& j, std::error_code& ec)
+        {
+            begin_item();
+            auto adaptor = make_json_visitor_adaptor<basic_json_visitor<typename T::char_type>>(encoder_);
+            j.dump(adaptor, ec);
+        }
+
+        template <class T>
+        typename std::enable_if<!type_traits::is_basic_json<T>::value>::type
+        write(const T& val, std::error_code& ec)
+        {
+            begin_item();
+            encode_traits<T,char>::encode(val, encoder_, json(), ec);
+        }
+
+        // Starts the next item, which is then written through the returned encoder
+        // as one complete data item
+        basic_cbor_encoder<Sink,Allocator>& begin_item()
+        {
+            if (count_ > 0)
+            {
+                encoder_.reset();
+            }
+            ++count_;
+            return encoder_;
+        }
+
+        void flush()
+        {
+            encoder_.flush();
+        }
+    };
+
+    using cbor_stream_sequence_writer = basic_cbor_sequence_writer<jsoncons::binary_stream_sink>;
+    using cbor_bytes_sequence_writer = basic_cbor_sequence_writer<jsoncons::bytes_sink<std::vector<uint8_t>>>;
+
+} // namespace cbor
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,407 @@
+// Copyright 2021 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_MULTI_DIM_ARRAY_HPP
+#define JSONCONS_CBOR_MULTI_DIM_ARRAY_HPP
+
+#include <vector>
+#include <memory>
+#include <initializer_list>
+#include <utility> // std::move
+#include <type_traits> // std::enable_if
+#include <system_error>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/decode_traits.hpp>
+#include <jsoncons/encode_traits.hpp>
+#include <jsoncons/config/binary_config.hpp>
+
+namespace jsoncons {
+namespace cbor {
+
+    // multi_dim_array
+    // The shape and elements of an RFC 8746 multi-dimensional array, with the elements
+    // held in one contiguous buffer in the array's row major or column major order.
+
+    template <class T, class Allocator=std::allocator<T>>
+    class multi_dim_array
+    {
+    public:
+        using value_type = T;
+    private:
+        std::vector<std::size_t> shape_;
+        std::vector<T,Allocator> values_;
+        semantic_tag order_;
+    public:
+        multi_dim_array(const Allocator& alloc = Allocator())
+            : values_(alloc), order_(semantic_tag::multi_dim_row_major)
+        {
+        }
+
+        multi_dim_array(std::vector<std::size_t> shape,
+                        semantic_tag order = semantic_tag::multi_dim_row_major,
+                        const Allocator& alloc = Allocator())
+            : shape_(std::move(shape)), values_(alloc), order_(order)
+        {
+            values_.resize(extent(shape_));
+        }
+
+        multi_dim_array(std::vector<std::size_t> shape,
+                        std::vector<T,Allocator> values,
+                        semantic_tag order = semantic_tag::multi_dim_row_major)
+            : shape_(std::move(shape)), values_(std::move(values)), order_(order)
+        {
+            JSONCONS_ASSERT(values_.size() == extent(shape_));
+        }
+
+        const std::vector<std::size_t>& shape() const
+        {
+            return shape_;
+        }
+
+        // semantic_tag::multi_dim_row_major or semantic_tag::multi_dim_column_major
+        semantic_tag order() const
+        {
+            return order_;
+        }
+
+        bool is_row_major() const
+        {
+            return order_ != semantic_tag::multi_dim_column_major;
+        }
+
+        // The distance in elements between neighbours along each dimension
+        std::vector<std::size_t> strides() const
+        {
+            std::vector<std::size_t> result(shape_.size());
+            std::size_t stride = 1;
+            if (is_row_major())
+            {
+                for (std::size_t i = shape_.size(); i-- > 0; )
+                {
+                    result[i] = stride;
+                    stride *= shape_[i];
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < shape_.size(); ++i)
+                {
+                    result[i] = stride;
+                    stride *= shape_[i];
+                }
+            }
+            return result;
+        }
+
+        std::size_t size() const
+        {
+            return values_.size();
+        }
+
+        T* data()
+        {
+            return values_.data();
+        }
+
+        const T* data() const
+        {
+            return values_.data();
+        }
+
+        std::vector<T,Allocator>& values()
+        {
+            return values_;
+        }
+
+        const std::vector<T,Allocator>& values() const
+        {
+            return values_;
+        }
+
+        T& operator()(std::initializer_list<std::size_t> index)
+        {
+            return values_[offset(index)];
+        }
+
+        const T& operator()(std::initializer_list<std::size_t> index) const
+        {
+            return values_[offset(index)];
+        }
+
+        friend bool operator==(const multi_dim_array& lhs, const multi_dim_array& rhs)
+        {
+            return lhs.shape_ == rhs.shape_ && lhs.is_row_major() == rhs.is_row_major() && lhs.values_ == rhs.values_;
+        }
+
+        friend bool operator!=(const multi_dim_array& lhs, const multi_dim_array& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        static std::size_t extent(const std::vector<std::size_t>& shape)
+        {
+            std::size_t n = 1;
+            for (auto dim : shape)
+            {
+                n *= dim;
+            }
+            return n;
+        }
+    private:
+        std::size_t offset(std::initializer_list<std::size_t> index) const
+        {
+            JSONCONS_ASSERT(index.size() == shape_.size());
+            std::vector<std::size_t> s = strides();
+            std::size_t pos = 0;
+            std::size_t i = 0;
+            for (auto k : index)
+            {
+                pos += k*s[i++];
+            }
+            return pos;
+        }
+    };
+
+namespace detail {
+
+    // Reads the elements of a multi-dimensional array. A typed array is taken in
+    // one call and converted in bulk, other arrays element by element.
+    template <class T, class Allocator>
+    class multi_dim_values_visitor : public default_json_visitor
+    {
+        std::vector<T,Allocator>& v_;
+        int level_;
+    public:
+        multi_dim_values_visitor(std::vector<T,Allocator>& v)
+            : default_json_visitor(false,conv_errc::not_vector), v_(v), level_(0)
+        {
+        }
+    private:
+        template <class U>
+        bool assign(const jsoncons::span<const U>& data)
+        {
+            v_.assign(data.begin(), data.end());
+            return false;
+        }
+
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (++level_ != 1)
+            {
+                ec = conv_errc::not_vector;
+                return false;
+            }
+            return true;
+        }
+
+        bool visit_begin_array(std::size_t size, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (++level_ != 1)
+            {
+                ec = conv_errc::not_vector;
+                return false;
+            }
+            v_.reserve(size);
+            return true;
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            return false;
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            v_.push_back(static_cast<T>(value));
+            return true;
+        }
+
+        bool visit_int64(int64_t value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            v_.push_back(static_cast<T>(value));
+            return true;
+        }
+
+        bool visit_half(uint16_t value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            v_.push_back(static_cast<T>(binary::decode_half(value)));
+            return true;
+        }
+
+        bool visit_double(double value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            v_.push_back(static_cast<T>(value));
+            return true;
+        }
+
+        bool visit_typed_array(const jsoncons::span<const uint8_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const uint16_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const uint32_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const uint64_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const int8_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const int16_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const int32_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const int64_t>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const float>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+
+        bool visit_typed_array(const jsoncons::span<const double>& data, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return assign(data);
+        }
+    };
+
+} // namespace detail
+
+} // namespace cbor
+
+    template <class T, class Allocator, class CharT>
+    struct decode_traits<cbor::multi_dim_array<T,Allocator>,CharT>
+    {
+        using value_type = cbor::multi_dim_array<T,Allocator>;
+
+        // Accepts a multi-dimensional array, or a one dimensional array of numbers
+        template <class Json,class TempAllocator>
+        static value_type decode(basic_staj_cursor<CharT>& cursor,
+                                 json_decoder<Json,TempAllocator>&,
+                                 std::error_code& ec)
+        {
+            cursor.array_expected(ec);
+            if (ec)
+            {
+                return value_type();
+            }
+            if (cursor.current().event_type() != staj_event_type::begin_array)
+            {
+                ec = conv_errc::not_vector;
+                return value_type();
+            }
+            const semantic_tag order = cursor.current().tag();
+            std::vector<std::size_t> shape;
+            std::vector<T,Allocator> values;
+
+            if (order == semantic_tag::multi_dim_row_major || order == semantic_tag::multi_dim_column_major)
+            {
+                cursor.next(ec);
+                if (ec || cursor.current().event_type() != staj_event_type::begin_array)
+                {
+                    ec = conv_errc::not_vector;
+                    return value_type();
+                }
+                cursor.next(ec);
+                while (!ec && cursor.current().event_type() == staj_event_type::uint64_value)
+                {
+                    shape.push_back(cursor.current().template get<std::size_t>(ec));
+                    cursor.next(ec);
+                }
+                if (ec || cursor.current().event_type() != staj_event_type::end_array)
+                {
+                    ec = conv_errc::not_vector;
+                    return value_type();
+                }
+                cursor.next(ec);
+                if (ec || !read_values(cursor, values, ec))
+                {
+                    return value_type();
+                }
+                cursor.next(ec);
+                if (ec || cursor.current().event_type() != staj_event_type::end_array)
+                {
+                    ec = conv_errc::not_vector;
+                    return value_type();
+                }
+                if (values.size() != value_type::extent(shape))
+                {
+                    ec = conv_errc::not_vector;
+                    return value_type();
+                }
+                return value_type(std::move(shape), std::move(values), order);
+            }
+            else
+            {
+                if (!read_values(cursor, values, ec))
+                {
+                    return value_type();
+                }
+                shape.push_back(values.size());
+                return value_type(std::move(shape), std::move(values));
+            }
+        }
+
+        static bool read_values(basic_staj_cursor<CharT>& cursor, std::vector<T,Allocator>& values, std::error_code& ec)
+        {
+            if (cursor.current().event_type() != staj_event_type::begin_array)
+            {
+                ec = conv_errc::not_vector;
+                return false;
+            }
+            cbor::detail::multi_dim_values_visitor<T,Allocator> visitor(values);
+            cursor.read_to(visitor, ec);
+            return !ec;
+        }
+    };
+
+    template <class T, class Allocator, class CharT>
+    struct encode_traits<cbor::multi_dim_array<T,Allocator>,CharT>
+    {
+        template <class Json>
+        static void encode(const cbor::multi_dim_array<T,Allocator>& val,
+                           basic_json_visitor<CharT>& encoder,
+                           const Json&,
+                           std::error_code& ec)
+        {
+            encoder.begin_multi_dim(jsoncons::span<const std::size_t>(val.shape()), val.order(), ser_context(), ec);
+            if (ec)
+            {
+                return;
+            }
+            encoder.typed_array(jsoncons::span<const T>(val.data(), val.size()), semantic_tag::none, ser_context(), ec);
+            if (ec)
+            {
+                return;
+            }
+            encoder.end_multi_dim(ser_context(), ec);
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -12,6 +12,7 @@
 #include <limits> // std::numeric_limits
 #include <memory>
 #include <utility> // std::move
+#include <cstring> // std::memmove
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
@@ -41,15 +42,26 @@ namespace msgpack {
         using sink_type = Sink;
 
     private:
+        using byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
+
+        static constexpr std::size_t known_length = (std::numeric_limits<std::size_t>::max)();
+
         struct stack_item
         {
             msgpack_container_type type_;
             std::size_t length_;
             std::size_t count_;
+            // The offset in the buffer of the header of a container of unknown length
+            std::size_t offset_;
+
+            stack_item(msgpack_container_type type, std::size_t length = 0, std::size_t offset = known_length) noexcept
+               : type_(type), length_(length), count_(0), offset_(offset)
+            {
+            }
 
-            stack_item(msgpack_container_type type, std::size_t length = 0) noexcept
-               : type_(type), length_(length), count_(0)
+            bool has_unknown_length() const
             {
+                return offset_ != known_length;
             }
 
             std::size_t length() const
@@ -68,12 +80,49 @@ namespace msgpack {
             }
         };
 
-        Sink sink_;
+        // Writes to the sink, or, while a container of unknown length is open,
+        // to a buffer, so that its length can be filled in when it ends
+        struct backpatch_sink
+        {
+            using value_type = uint8_t;
+
+            Sink sink;
+            std::vector<uint8_t,byte_allocator_type> buffer;
+            bool buffering;
+
+            backpatch_sink(Sink&& sink, const allocator_type& alloc)
+                : sink(std::forward<Sink>(sink)), buffer(alloc), buffering(false)
+            {
+            }
+
+            void push_back(uint8_t b)
+            {
+                if (JSONCONS_UNLIKELY(buffering))
+                {
+                    buffer.push_back(b);
+                }
+                else
+                {
+                    sink.push_back(b);
+                }
+            }
+
+            void flush()
+            {
+                sink.flush();
+            }
+        };
+
+        backpatch_sink sink_;
         const msgpack_encode_options options_;
         allocator_type alloc_;
 
         std::vector<stack_item> stack_;
         int nesting_depth_;
+        // The open containers of unknown length
+        int unknown_length_depth_;
+        // The offsets of the headers in the buffer, in order
+        std::vector<std::size_t> header_offsets_;
 
         // Noncopyable and nonmoveable
         basic_msgpack_encoder(const basic_msgpack_encoder&) = delete;
@@ -88,10 +137,11 @@ namespace msgpack {
         explicit basic_msgpack_encoder(Sink&& sink, 
                                        const msgpack_encode_options& options, 
                                        const Allocator& alloc = Allocator())
-           : sink_(std::forward<Sink>(sink)),
+           : sink_(std::forward<Sink>(sink), alloc),
              options_(options),
              alloc_(alloc),
-             nesting_depth_(0)
+             nesting_depth_(0),
+             unknown_length_depth_(0)
         {
         }
 
@@ -104,11 +154,15 @@ namespace msgpack {
         {
             stack_.clear();
             nesting_depth_ = 0;
+            unknown_length_depth_ = 0;
+            header_offsets_.clear();
+            sink_.buffer.clear();
+            sink_.buffering = false;
         }
 
         void reset(Sink&& sink)
         {
-            sink_ = std::move(sink);
+            sink_.sink = std::move(sink);
             reset();
         }
 
@@ -122,8 +176,18 @@ namespace msgpack {
 
         bool visit_begin_object(semantic_tag, const ser_context&, std::error_code& ec) override
         {
-            ec = msgpack_errc::object_length_required;
-            return false;
+            if (!options_.backpatch_lengths())
+            {
+                ec = msgpack_errc::object_length_required;
+                return false;
+            }
+            if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+            {
+                ec = msgpack_errc::max_nesting_depth_exceeded;
+                return false;
+            } 
+            begin_unknown_length(msgpack_container_type::object, jsoncons::msgpack::msgpack_type::map32_type);
+            return true;
         }
 
         bool visit_begin_object(std::size_t length, semantic_tag, const ser_context&, std::error_code& ec) override
@@ -163,7 +227,14 @@ namespace msgpack {
             JSONCONS_ASSERT(!stack_.empty());
             --nesting_depth_;
 
-            if (stack_.back().count() < stack_.back().length())
+            if (stack_.back().has_unknown_length())
+            {
+                if (!end_unknown_length(ec))
+                {
+                    return false;
+                }
+            }
+            else if (stack_.back().count() < stack_.back().length())
             {
                 ec = msgpack_errc::too_few_items;
                 return false;
@@ -181,8 +252,18 @@ namespace msgpack {
 
         bool visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
         {
-            ec = msgpack_errc::array_length_required;
-            return false;
+            if (!options_.backpatch_lengths())
+            {
+                ec = msgpack_errc::array_length_required;
+                return false;
+            }
+            if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+            {
+                ec = msgpack_errc::max_nesting_depth_exceeded;
+                return false;
+            } 
+            begin_unknown_length(msgpack_container_type::array, jsoncons::msgpack::msgpack_type::array32_type);
+            return true;
         }
 
         bool visit_begin_array(std::size_t length, semantic_tag, const ser_context&, std::error_code& ec) override
@@ -219,7 +300,14 @@ namespace msgpack {
 
             --nesting_depth_;
 
-            if (stack_.back().count() < stack_.back().length())
+            if (stack_.back().has_unknown_length())
+            {
+                if (!end_unknown_length(ec))
+                {
+                    return false;
+                }
+            }
+            else if (stack_.back().count() < stack_.back().length())
             {
                 ec = msgpack_errc::too_few_items;
                 return false;
@@ -731,6 +819,94 @@ namespace msgpack {
                 ++stack_.back().count_;
             }
         }
+
+        // Writes a map 32 or array 32 header with a zero length, and holds the
+        // encoded bytes until the outermost container of unknown length ends
+        void begin_unknown_length(msgpack_container_type type, uint8_t header_type)
+        {
+            if (unknown_length_depth_++ == 0)
+            {
+                sink_.buffering = true;
+            }
+            std::size_t offset = sink_.buffer.size();
+            stack_.emplace_back(type, 0, offset);
+            if (options_.compact_lengths())
+            {
+                header_offsets_.push_back(offset);
+            }
+            sink_.push_back(header_type);
+            binary::native_to_big(static_cast<uint32_t>(0), std::back_inserter(sink_));
+        }
+
+        bool end_unknown_length(std::error_code& ec)
+        {
+            const stack_item& item = stack_.back();
+            if (item.count() > (std::numeric_limits<uint32_t>::max)())
+            {
+                ec = msgpack_errc::too_many_items;
+                return false;
+            }
+            binary::native_to_big(static_cast<uint32_t>(item.count()), sink_.buffer.data() + item.offset_ + 1);
+            if (--unknown_length_depth_ == 0)
+            {
+                if (options_.compact_lengths())
+                {
+                    compact_lengths();
+                }
+                sink_.buffering = false;
+                for (auto b : sink_.buffer)
+                {
+                    sink_.sink.push_back(b);
+                }
+                sink_.buffer.clear();
+            }
+            return true;
+        }
+
+        // Rewrites the map 32 and array 32 headers in the buffer in their shortest form,
+        // moving the bytes between them down in one pass
+        void compact_lengths()
+        {
+            uint8_t* data = sink_.buffer.data();
+            std::size_t read = 0;
+            std::size_t write = 0;
+            for (auto offset : header_offsets_)
+            {
+                if (write != read)
+                {
+                    std::memmove(data + write, data + read, offset - read);
+                }
+                write += offset - read;
+
+                const bool is_map = data[offset] == jsoncons::msgpack::msgpack_type::map32_type;
+                uint32_t length = binary::big_to_native<uint32_t>(data + offset + 1, sizeof(uint32_t));
+                uint8_t* p = data + write;
+                if (length <= 15)
+                {
+                    *p++ = static_cast<uint8_t>((is_map ? jsoncons::msgpack::msgpack_type::fixmap_base_type : jsoncons::msgpack::msgpack_type::fixarray_base_type) | length);
+                }
+                else if (length <= (std::numeric_limits<uint16_t>::max)())
+                {
+                    *p++ = is_map ? jsoncons::msgpack::msgpack_type::map16_type : jsoncons::msgpack::msgpack_type::array16_type;
+                    binary::native_to_big(static_cast<uint16_t>(length), p);
+                    p += sizeof(uint16_t);
+                }
+                else
+                {
+                    *p++ = data[offset];
+                    binary::native_to_big(length, p);
+                    p += sizeof(uint32_t);
+                }
+                write = static_cast<std::size_t>(p - data);
+                read = offset + 1 + sizeof(uint32_t);
+            }
+            if (write != read)
+            {
+                std::memmove(data + write, data + read, sink_.buffer.size() - read);
+            }
+            sink_.buffer.resize(write + (sink_.buffer.size() - read));
+            header_offsets_.clear();
+        }
     };
 
     using msgpack_stream_encoder = basic_msgpack_encoder<jsoncons::binary_stream_sink>;
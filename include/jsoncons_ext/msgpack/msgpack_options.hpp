@@ -52,9 +52,23 @@ public:
 class msgpack_encode_options : public virtual msgpack_options_common
 {
     friend class msgpack_options;
+
+    bool backpatch_lengths_;
+    bool compact_lengths_;
 public:
     msgpack_encode_options()
+        : backpatch_lengths_(false), compact_lengths_(false)
+    {
+    }
+
+    bool backpatch_lengths() const
     {
+        return backpatch_lengths_;
+    }
+
+    bool compact_lengths() const
+    {
+        return compact_lengths_;
     }
 };
 
@@ -62,12 +76,26 @@ class msgpack_options final : public msgpack_decode_options, public msgpack_enco
 {
 public:
     using msgpack_options_common::max_nesting_depth;
+    using msgpack_encode_options::backpatch_lengths;
+    using msgpack_encode_options::compact_lengths;
 
     msgpack_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    msgpack_options& backpatch_lengths(bool value)
+    {
+        this->backpatch_lengths_ = value;
+        return *this;
+    }
+
+    msgpack_options& compact_lengths(bool value)
+    {
+        this->compact_lengths_ = value;
+        return *this;
+    }
 };
 
 }}
@@ -195,6 +195,143 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the array or map that was begun by the last event,
+    // following the length prefixes without decoding the items, then reports its end.
+    void skip_container(json_visitor2& visitor, std::error_code& ec)
+    {
+        bool is_array = state_stack_.back().mode == parse_mode::array;
+        uint64_t count = state_stack_.back().length - state_stack_.back().index;
+        if (!is_array)
+        {
+            count *= 2;
+            if (state_stack_.back().mode == parse_mode::map_value)
+            {
+                ++count;
+            }
+        }
+
+        for (; count > 0; --count)
+        {
+            uint8_t type;
+            if (source_.read(&type, 1) == 0)
+            {
+                ec = msgpack_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+
+            std::size_t length = 0;
+            if (type <= 0x7f || type >= 0xe0)
+            {
+                // positive or negative fixint
+            }
+            else if (type >= msgpack_type::fixmap_base_type && type <= 0x8f)
+            {
+                count += 2*(type & 0x0f);
+            }
+            else if (type >= msgpack_type::fixarray_base_type && type <= 0x9f)
+            {
+                count += type & 0x0f;
+            }
+            else if (type >= msgpack_type::fixstr_base_type && type <= 0xbf)
+            {
+                length = type & 0x1f;
+            }
+            else
+            {
+                switch (type)
+                {
+                    case msgpack_type::nil_type:
+                    case msgpack_type::false_type:
+                    case msgpack_type::true_type:
+                        break;
+                    case msgpack_type::uint8_type:
+                    case msgpack_type::int8_type:
+                        length = 1;
+                        break;
+                    case msgpack_type::uint16_type:
+                    case msgpack_type::int16_type:
+                        length = 2;
+                        break;
+                    case msgpack_type::uint32_type:
+                    case msgpack_type::int32_type:
+                    case msgpack_type::float32_type:
+                        length = 4;
+                        break;
+                    case msgpack_type::uint64_type:
+                    case msgpack_type::int64_type:
+                    case msgpack_type::float64_type:
+                        length = 8;
+                        break;
+                    case msgpack_type::fixext1_type:
+                        length = 2;
+                        break;
+                    case msgpack_type::fixext2_type:
+                        length = 3;
+                        break;
+                    case msgpack_type::fixext4_type:
+                        length = 5;
+                        break;
+                    case msgpack_type::fixext8_type:
+                        length = 9;
+                        break;
+                    case msgpack_type::fixext16_type:
+                        length = 17;
+                        break;
+                    case msgpack_type::str8_type:
+                    case msgpack_type::str16_type:
+                    case msgpack_type::str32_type:
+                    case msgpack_type::bin8_type:
+                    case msgpack_type::bin16_type:
+                    case msgpack_type::bin32_type:
+                        length = get_size(type, ec);
+                        break;
+                    case msgpack_type::ext8_type:
+                    case msgpack_type::ext16_type:
+                    case msgpack_type::ext32_type:
+                        length = get_size(type, ec) + 1; // ext type follows the length
+                        break;
+                    case msgpack_type::array16_type:
+                    case msgpack_type::array32_type:
+                        count += get_size(type, ec);
+                        break;
+                    case msgpack_type::map16_type:
+                    case msgpack_type::map32_type:
+                        count += 2*uint64_t(get_size(type, ec));
+                        break;
+                    default:
+                        ec = msgpack_errc::unknown_type;
+                        more_ = false;
+                        return;
+                }
+                if (ec)
+                {
+                    return;
+                }
+            }
+            if (length > 0)
+            {
+                std::size_t pos = source_.position();
+                source_.ignore(length);
+                if (source_.position() - pos != length)
+                {
+                    ec = msgpack_errc::unexpected_eof;
+                    more_ = false;
+                    return;
+                }
+            }
+        }
+
+        if (is_array)
+        {
+            end_array(visitor, ec);
+        }
+        else
+        {
+            end_object(visitor, ec);
+        }
+    }
 private:
 
     void read_item(json_visitor2& visitor, std::error_code& ec)
@@ -186,6 +186,28 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        if (!done() && (cursor_visitor_.event().event_type() == staj_event_type::begin_object || 
+                        cursor_visitor_.event().event_type() == staj_event_type::begin_array))
+        {
+            parser_.restart();
+            parser_.skip_container(cursor_visitor_, ec);
+            if (ec) return;
+        }
+        read_next(ec);
+    }
+
     const ser_context& context() const override
     {
         return *this;
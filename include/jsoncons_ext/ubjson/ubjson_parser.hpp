@@ -8,7 +8,9 @@
 #define JSONCONS_UBJSON_UBJSON_PARSER_HPP
 
 #include <string>
+#include <vector>
 #include <memory>
+#include <limits> // std::numeric_limits
 #include <utility> // std::move
 #include <jsoncons/json.hpp>
 #include <jsoncons/source.hpp>
@@ -310,7 +312,243 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the array or object that was begun by the last event,
+    // following the counts and lengths without decoding the items, then reports its end.
+    // The fixed size values of a strongly typed array are skipped as one range.
+    void skip_container(json_visitor& visitor, std::error_code& ec)
+    {
+        std::vector<skip_frame> frames;
+        const parse_state& state = state_stack_.back();
+        switch (state.mode)
+        {
+            case parse_mode::array:
+            case parse_mode::strongly_typed_array:
+                frames.emplace_back(false, false, state.length - state.index, state.type);
+                break;
+            case parse_mode::indefinite_array:
+                frames.emplace_back(false, true, 0, 0);
+                break;
+            case parse_mode::map_key:
+            case parse_mode::strongly_typed_map_key:
+                frames.emplace_back(true, false, state.length - state.index, state.type);
+                break;
+            case parse_mode::indefinite_map_key:
+                frames.emplace_back(true, true, 0, 0);
+                break;
+            default:
+                return;
+        }
+        bool is_array = !frames.back().is_object;
+
+        while (!frames.empty())
+        {
+            skip_frame& frame = frames.back();
+            if (frame.indefinite && (!frame.is_object || frame.key_next))
+            {
+                auto c = source_.peek();
+                if (c.eof)
+                {
+                    ec = ubjson_errc::unexpected_eof;
+                    more_ = false;
+                    return;
+                }
+                if (c.value == (frame.is_object ? jsoncons::ubjson::ubjson_type::end_object_marker : jsoncons::ubjson::ubjson_type::end_array_marker))
+                {
+                    source_.ignore(1);
+                    frames.pop_back();
+                    continue;
+                }
+            }
+            else if (!frame.indefinite && frame.remaining == 0 && (!frame.is_object || frame.key_next))
+            {
+                frames.pop_back();
+                continue;
+            }
+
+            if (frame.is_object && frame.key_next)
+            {
+                std::size_t length = get_length(ec);
+                if (ec)
+                {
+                    ec = ubjson_errc::key_expected;
+                    return;
+                }
+                frame.key_next = false;
+                skip_bytes(length, ec);
+                if (ec) return;
+                continue;
+            }
+
+            uint8_t type = frame.type;
+            std::size_t size = fixed_value_size(type);
+            if (!frame.is_object && type != 0 && size != (std::numeric_limits<std::size_t>::max)())
+            {
+                if (size != 0 && frame.remaining > (std::numeric_limits<std::size_t>::max)() / size)
+                {
+                    ec = ubjson_errc::number_too_large;
+                    more_ = false;
+                    return;
+                }
+                skip_bytes(size*frame.remaining, ec);
+                if (ec) return;
+                frame.remaining = 0;
+                continue;
+            }
+            if (!frame.indefinite)
+            {
+                --frame.remaining;
+            }
+            frame.key_next = frame.is_object;
+            if (type == 0 && source_.read(&type, 1) == 0)
+            {
+                ec = ubjson_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+
+            // frame may be invalidated from here
+            size = fixed_value_size(type);
+            if (size != (std::numeric_limits<std::size_t>::max)())
+            {
+                skip_bytes(size, ec);
+            }
+            else
+            {
+                switch (type)
+                {
+                    case jsoncons::ubjson::ubjson_type::string_type:
+                    case jsoncons::ubjson::ubjson_type::high_precision_number_type:
+                    {
+                        std::size_t length = get_length(ec);
+                        if (ec) return;
+                        skip_bytes(length, ec);
+                        break;
+                    }
+                    case jsoncons::ubjson::ubjson_type::start_array_marker:
+                    case jsoncons::ubjson::ubjson_type::start_object_marker:
+                        skip_container_header(type == jsoncons::ubjson::ubjson_type::start_object_marker, frames, ec);
+                        break;
+                    default:
+                        ec = ubjson_errc::unknown_type;
+                        more_ = false;
+                        break;
+                }
+            }
+            if (ec) return;
+        }
+
+        if (is_array)
+        {
+            end_array(visitor, ec);
+        }
+        else
+        {
+            end_object(visitor, ec);
+        }
+    }
+
 private:
+    struct skip_frame
+    {
+        bool is_object;
+        bool indefinite;
+        bool key_next;
+        std::size_t remaining;
+        uint8_t type;
+
+        skip_frame(bool is_object, bool indefinite, std::size_t remaining, uint8_t type)
+            : is_object(is_object), indefinite(indefinite), key_next(is_object), remaining(remaining), type(type)
+        {
+        }
+    };
+
+    // Returns the size of a value of the given type that follows the type marker,
+    // or the maximum size_t if the size is not fixed
+    static std::size_t fixed_value_size(uint8_t type)
+    {
+        switch (type)
+        {
+            case jsoncons::ubjson::ubjson_type::null_type:
+            case jsoncons::ubjson::ubjson_type::no_op_type:
+            case jsoncons::ubjson::ubjson_type::true_type:
+            case jsoncons::ubjson::ubjson_type::false_type:
+                return 0;
+            case jsoncons::ubjson::ubjson_type::int8_type:
+            case jsoncons::ubjson::ubjson_type::uint8_type:
+            case jsoncons::ubjson::ubjson_type::char_type:
+                return 1;
+            case jsoncons::ubjson::ubjson_type::int16_type:
+                return 2;
+            case jsoncons::ubjson::ubjson_type::int32_type:
+            case jsoncons::ubjson::ubjson_type::float32_type:
+                return 4;
+            case jsoncons::ubjson::ubjson_type::int64_type:
+            case jsoncons::ubjson::ubjson_type::float64_type:
+                return 8;
+            default:
+                return (std::numeric_limits<std::size_t>::max)();
+        }
+    }
+
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t pos = source_.position();
+        source_.ignore(length);
+        if (source_.position() - pos != length)
+        {
+            ec = ubjson_errc::unexpected_eof;
+            more_ = false;
+        }
+    }
+
+    // Reads the optional type and count that follow the start of an array or object
+    void skip_container_header(bool is_object, std::vector<skip_frame>& frames, std::error_code& ec)
+    {
+        auto c = source_.peek();
+        if (c.eof)
+        {
+            ec = ubjson_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+        uint8_t type = 0;
+        if (c.value == jsoncons::ubjson::ubjson_type::type_marker)
+        {
+            source_.ignore(1);
+            if (source_.read(&type, 1) == 0)
+            {
+                ec = ubjson_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+            c = source_.peek();
+            if (c.eof)
+            {
+                ec = ubjson_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+            if (c.value != jsoncons::ubjson::ubjson_type::count_marker)
+            {
+                ec = ubjson_errc::count_required_after_type;
+                more_ = false;
+                return;
+            }
+        }
+        if (c.value == jsoncons::ubjson::ubjson_type::count_marker)
+        {
+            source_.ignore(1);
+            std::size_t length = get_length(ec);
+            if (ec) return;
+            frames.emplace_back(is_object, false, length, type);
+        }
+        else
+        {
+            frames.emplace_back(is_object, true, 0, 0);
+        }
+    }
+
     void read_type_and_value(json_visitor& visitor, std::error_code& ec)
     {
         if (source_.is_error())
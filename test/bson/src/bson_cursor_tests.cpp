@@ -304,3 +304,115 @@ TEMPLATE_TEST_CASE("bson_cursor reset test", "",
         check_bson_cursor_document("third document", cursor, "c", 3);
     }
 }
+
+namespace {
+
+    // Returns the events that follow each member of the root object, skipping 
+    // nested containers with skip() or by stepping through their events with next()
+    template <class Cursor>
+    std::vector<std::string> events_after_skip(Cursor& cursor, bool use_skip)
+    {
+        std::vector<std::string> events;
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        while (!cursor.done())
+        {
+            const auto& event = cursor.current();
+            std::ostringstream os;
+            os << event.event_type();
+            if (event.event_type() == staj_event_type::key || event.event_type() == staj_event_type::string_value)
+            {
+                os << " " << event.template get<std::string>();
+            }
+            events.push_back(os.str());
+            if (event.event_type() == staj_event_type::begin_object || event.event_type() == staj_event_type::begin_array)
+            {
+                if (use_skip)
+                {
+                    cursor.skip();
+                }
+                else
+                {
+                    int depth = 0;
+                    do
+                    {
+                        auto type = cursor.current().event_type();
+                        if (type == staj_event_type::begin_object || type == staj_event_type::begin_array)
+                        {
+                            ++depth;
+                        }
+                        else if (type == staj_event_type::end_object || type == staj_event_type::end_array)
+                        {
+                            --depth;
+                        }
+                        cursor.next();
+                    }
+                    while (depth > 0);
+                }
+            }
+            else
+            {
+                cursor.next();
+            }
+        }
+        return events;
+    }
+
+} // namespace
+
+TEST_CASE("bson_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "a" : [1, [2, "three"], {"x" : 1.5, "y" : -1000000, "z" : 4294967296}],
+        "b" : {"c" : {"d" : [true, null, false]}, "e" : "a text string"},
+        "f" : -7,
+        "h" : [],
+        "i" : {},
+        "j" : "a text string"
+    }
+    )");
+    j["g"] = ojson(byte_string_arg, std::vector<uint8_t>{1,2,3,4,5});
+
+    std::vector<uint8_t> data;
+    bson::encode_bson(j, data);
+
+    SECTION("bytes cursor")
+    {
+        bson::bson_bytes_cursor cursor1(data);
+        bson::bson_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 15);
+    }
+
+    SECTION("stream cursor")
+    {
+        std::string buffer(data.begin(), data.end());
+        std::istringstream is1(buffer);
+        std::istringstream is2(buffer);
+        bson::bson_stream_cursor cursor1(is1);
+        bson::bson_stream_cursor cursor2(is2);
+        CHECK(events_after_skip(cursor1, true) == events_after_skip(cursor2, false));
+    }
+
+    SECTION("unexpected eof")
+    {
+        data.resize(data.size() - 10);
+        bson::bson_bytes_cursor cursor(data);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK_FALSE(ec);
+        while (!ec && !cursor.done())
+        {
+            cursor.skip(ec);
+        }
+        CHECK(ec == bson::bson_errc::unexpected_eof);
+    }
+}
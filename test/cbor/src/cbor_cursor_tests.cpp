@@ -385,3 +385,147 @@ TEMPLATE_TEST_CASE("cbor_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+namespace {
+
+    // Returns the events that follow each member of the root object, skipping 
+    // nested containers with skip() or by stepping through their events with next()
+    std::vector<std::string> events_after_skip(cbor::cbor_bytes_cursor& cursor, bool use_skip)
+    {
+        std::vector<std::string> events;
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        while (!cursor.done())
+        {
+            const auto& event = cursor.current();
+            std::ostringstream os;
+            os << event.event_type();
+            if (event.event_type() == staj_event_type::key || event.event_type() == staj_event_type::string_value)
+            {
+                os << " " << event.get<std::string>();
+            }
+            events.push_back(os.str());
+            if (event.event_type() == staj_event_type::begin_object || event.event_type() == staj_event_type::begin_array)
+            {
+                if (use_skip)
+                {
+                    cursor.skip();
+                }
+                else
+                {
+                    int depth = 0;
+                    do
+                    {
+                        auto type = cursor.current().event_type();
+                        if (type == staj_event_type::begin_object || type == staj_event_type::begin_array)
+                        {
+                            ++depth;
+                        }
+                        else if (type == staj_event_type::end_object || type == staj_event_type::end_array)
+                        {
+                            --depth;
+                        }
+                        cursor.next();
+                    }
+                    while (depth > 0);
+                }
+            }
+            else
+            {
+                cursor.next();
+            }
+        }
+        return events;
+    }
+
+} // namespace
+
+TEST_CASE("cbor_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "a" : [1, [2, "three"], {"x" : 1.5, "y" : -1000000}],
+        "b" : {"c" : {"d" : [true, null]}, "e" : "a text string that is long enough"},
+        "f" : -7,
+        "h" : [],
+        "i" : {},
+        "j" : "a text string that is long enough"
+    }
+    )");
+    j["g"] = ojson(byte_string_arg, std::vector<uint8_t>{1,2,3,4,5}, semantic_tag::base64url);
+    j["k"] = ojson("2021-01-01T00:00:00Z", semantic_tag::datetime);
+    j["l"] = ojson::parse("[[1,2],[3,4]]");
+
+    SECTION("default options")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+
+        cbor::cbor_bytes_cursor cursor1(data);
+        cbor::cbor_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 19);
+    }
+
+    SECTION("pack strings")
+    {
+        std::vector<uint8_t> data;
+        cbor::cbor_options options;
+        options.pack_strings(true);
+        cbor::encode_cbor(j, data, options);
+
+        cbor::cbor_bytes_cursor cursor1(data);
+        cbor::cbor_bytes_cursor cursor2(data);
+        CHECK(events_after_skip(cursor1, true) == events_after_skip(cursor2, false));
+    }
+
+    SECTION("typed arrays")
+    {
+        std::vector<uint8_t> data;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::cbor_bytes_encoder encoder(data, options);
+        std::vector<uint16_t> v = {1,2,3};
+        encoder.begin_object();
+        encoder.key("a");
+        encoder.typed_array(jsoncons::span<const uint16_t>(v));
+        encoder.key("b");
+        encoder.begin_array();
+        encoder.typed_array(jsoncons::span<const uint16_t>(v));
+        encoder.end_array();
+        encoder.key("c");
+        encoder.uint64_value(4);
+        encoder.end_object();
+        encoder.flush();
+
+        cbor::cbor_bytes_cursor cursor1(data);
+        cbor::cbor_bytes_cursor cursor2(data);
+        CHECK(events_after_skip(cursor1, true) == events_after_skip(cursor2, false));
+    }
+
+    SECTION("indefinite length")
+    {
+        // {_ "a": [_ 1, (_ h'01', h'02'), {_ "b": 0}], "c": (_ "x", "y"), "d": [2]}
+        std::vector<uint8_t> data = {0xbf,
+                                     0x61,'a',0x9f,0x01,0x5f,0x41,0x01,0x41,0x02,0xff,0xbf,0x61,'b',0x00,0xff,0xff,
+                                     0x61,'c',0x7f,0x61,'x',0x61,'y',0xff,
+                                     0x61,'d',0x81,0xc1,0x02,
+                                     0xff};
+        cbor::cbor_bytes_cursor cursor1(data);
+        cbor::cbor_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 7);
+    }
+
+    SECTION("unexpected eof")
+    {
+        std::vector<uint8_t> data = {0x82,0x83,0x01,0x02};
+        cbor::cbor_bytes_cursor cursor(data);
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+}
@@ -415,6 +415,41 @@ TEST_CASE("encode stringref")
     CHECK(j2 == j);
 }
 
+TEST_CASE("cbor encode with pack_strings and many repeated strings")
+{
+    // More distinct strings than the first stringref table capacity, of lengths on both
+    // sides of the minimum lengths for stringrefs, with text and byte strings that have
+    // the same bytes
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < 600; ++i)
+    {
+        names.push_back(std::string(3 + i % 37, static_cast<char>('a' + i % 26)) + std::to_string(i));
+    }
+
+    json j(json_array_arg);
+    for (std::size_t i = 0; i < 3000; ++i)
+    {
+        const std::string& name = names[(i * 7) % names.size()];
+        json item(json_object_arg);
+        item.try_emplace(names[i % 5], name);
+        item.try_emplace("bytes", byte_string_arg, std::vector<uint8_t>(name.begin(), name.end()));
+        item.try_emplace("tagged", byte_string_arg, std::vector<uint8_t>(name.begin(), name.end()), 1234);
+        j.push_back(std::move(item));
+    }
+
+    cbor::cbor_options options;
+    options.pack_strings(true);
+    std::vector<uint8_t> packed;
+    cbor::encode_cbor(j, packed, options);
+
+    std::vector<uint8_t> plain;
+    cbor::encode_cbor(j, plain);
+    CHECK(packed.size() < plain.size() / 2);
+
+    json j2 = cbor::decode_cbor<json>(packed);
+    CHECK(j2 == j);
+}
+
 TEST_CASE("cbor encode with semantic_tags")
 {
     SECTION("string")
@@ -5,10 +5,13 @@
 #include "windows.h"
 #endif
 #include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
 #include <jsoncons_ext/cbor/cbor.hpp>
 #include <jsoncons_ext/cbor/cbor_reader.hpp>
 #include <catch/catch.hpp>
 #include <sstream>
+#include <fstream>
+#include <cstdio>
 #include <vector>
 #include <utility>
 #include <ctime>
@@ -734,3 +737,23 @@ TEST_CASE("CBOR stringref tag 3")
 
     CHECK(j == expected);
 }
+
+TEST_CASE("cbor_reader with mmap_binary_source")
+{
+    json expected = json::parse(R"({"a":[1,-2,2.5,"abc",true,null],"b":{"c":"d"}})");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(expected, data);
+
+    std::string path = "./output/cbor_mmap_source.cbor";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    json_decoder<json> decoder;
+    cbor::basic_cbor_reader<mmap_binary_source> reader(mmap_binary_source(path), decoder);
+    reader.read();
+    CHECK(decoder.get_result() == expected);
+
+    std::remove(path.c_str());
+}
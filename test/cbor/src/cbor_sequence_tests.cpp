@@ -0,0 +1,278 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/cbor/cbor_sequence_reader.hpp>
+#include <jsoncons_ext/cbor/cbor_sequence_writer.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_item(std::size_t i)
+    {
+        json j(json_object_arg);
+        j.try_emplace("id", i);
+        j.try_emplace("name", "a name that is too long for a short string " + std::to_string(i % 7));
+        j.try_emplace("values", json::parse("[1,2.5,true,null]"));
+        return j;
+    }
+
+    std::vector<uint8_t> make_sequence(std::size_t n, const cbor::cbor_encode_options& options = cbor::cbor_encode_options())
+    {
+        std::vector<uint8_t> data;
+        {
+            cbor::cbor_bytes_sequence_writer writer(data, options);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                writer.write(make_item(i));
+            }
+            CHECK(writer.size() == n);
+        }
+        return data;
+    }
+
+}
+
+TEST_CASE("cbor_sequence_reader tests")
+{
+    const std::size_t n = 1000;
+    std::vector<uint8_t> input = make_sequence(n);
+
+    SECTION("ordered")
+    {
+        for (std::size_t threads : {0, 1, 2, 4})
+        {
+            std::vector<json> values;
+            std::vector<std::size_t> indices;
+            cbor::cbor_sequence_reader<json> reader(input);
+            reader.num_threads(threads).chunk_size(100);
+            std::size_t count = reader.read([&](json&& j, std::size_t index)
+            {
+                values.push_back(std::move(j));
+                indices.push_back(index);
+            });
+            REQUIRE(count == n);
+            REQUIRE(values.size() == n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                CHECK(values[i] == make_item(i));
+                CHECK(indices[i] == i);
+            }
+        }
+    }
+
+    SECTION("unordered")
+    {
+        std::vector<std::size_t> ids;
+        cbor::cbor_sequence_reader<ojson> reader(input);
+        reader.num_threads(4).chunk_size(64).preserve_order(false);
+        std::size_t count = reader.read([&](ojson&& j, std::size_t index)
+        {
+            CHECK(j["id"].as<std::size_t>() == index);
+            ids.push_back(index);
+        });
+        REQUIRE(count == n);
+        std::sort(ids.begin(), ids.end());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(ids[i] == i);
+        }
+    }
+
+    SECTION("stream")
+    {
+        for (std::size_t chunk_size : {1, 50, 1024*1024})
+        {
+            std::string s(input.begin(), input.end());
+            std::istringstream is(s);
+            std::vector<std::size_t> ids;
+            cbor::cbor_sequence_reader<json> reader(is);
+            reader.num_threads(3).chunk_size(chunk_size);
+            std::size_t count = reader.read([&](json&& j, std::size_t)
+            {
+                ids.push_back(j["id"].as<std::size_t>());
+            });
+            REQUIRE(count == n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                CHECK(ids[i] == i);
+            }
+        }
+    }
+
+    SECTION("packed strings")
+    {
+        std::vector<uint8_t> packed = make_sequence(n, cbor::cbor_options().pack_strings(true));
+        std::size_t count = 0;
+        cbor::cbor_sequence_reader<json> reader(packed);
+        reader.num_threads(4).chunk_size(200);
+        reader.read([&](json&& j, std::size_t index)
+        {
+            CHECK(j == make_item(index));
+            ++count;
+        });
+        CHECK(count == n);
+    }
+}
+
+TEST_CASE("cbor_sequence_reader into T")
+{
+    std::vector<uint8_t> data;
+    {
+        cbor::cbor_bytes_sequence_writer writer(data);
+        for (int i = 0; i < 100; ++i)
+        {
+            std::vector<double> v(static_cast<std::size_t>(i), i + 0.5);
+            writer.write(v);
+        }
+    }
+
+    for (std::size_t threads : {1, 4})
+    {
+        std::size_t count = 0;
+        cbor::cbor_sequence_reader<std::vector<double>> reader(data);
+        reader.num_threads(threads).chunk_size(128);
+        reader.read([&](std::vector<double>&& v, std::size_t index)
+        {
+            CHECK(v == std::vector<double>(index, index + 0.5));
+            ++count;
+        });
+        CHECK(count == 100);
+    }
+}
+
+TEST_CASE("cbor_sequence_reader item forms")
+{
+    std::vector<uint8_t> data = {
+        0x01,                               // 1
+        0x9f, 0x01, 0x82, 0x02, 0x03, 0xff, // [_ 1, [2, 3]]
+        0xbf, 0x61, 0x61, 0x01, 0xff,       // {_ "a": 1}
+        0xc1, 0x1a, 0x51, 0x4b, 0x67, 0xb0, // 1(1363896240)
+        0x7f, 0x61, 0x61, 0x61, 0x62, 0xff, // (_ "a", "b")
+        0xd9, 0x01, 0x00, 0x82, 0x63, 0x61, 0x62, 0x63, 0xd8, 0x19, 0x00, // 256([ "abc", 25(0) ])
+        0xf6                                // null
+    };
+
+    std::vector<json> values;
+    cbor::cbor_sequence_reader<json> reader(data);
+    reader.num_threads(2).chunk_size(1);
+    reader.read([&](json&& j, std::size_t)
+    {
+        values.push_back(std::move(j));
+    });
+    REQUIRE(values.size() == 7);
+    CHECK(values[0] == json(1));
+    CHECK(values[1] == json::parse("[1,[2,3]]"));
+    CHECK(values[2] == json::parse(R"({"a":1})"));
+    CHECK(values[3].as<int64_t>() == 1363896240);
+    CHECK(values[4] == json("ab"));
+    CHECK(values[5] == json::parse(R"(["abc","abc"])"));
+    CHECK(values[6].is_null());
+}
+
+TEST_CASE("cbor_sequence_reader errors")
+{
+    std::vector<uint8_t> input = make_sequence(500);
+    const std::size_t good_size = input.size();
+
+    SECTION("truncated last item")
+    {
+        std::vector<uint8_t> truncated(input.begin(), input.end() - 3);
+        for (std::size_t threads : {1, 4})
+        {
+            std::error_code ec;
+            cbor::cbor_sequence_reader<json> reader(truncated);
+            reader.num_threads(threads).chunk_size(128);
+            std::size_t count = reader.read([](json&&, std::size_t){}, ec);
+            CHECK(ec == cbor::cbor_errc::unexpected_eof);
+            CHECK(count == 499);
+            CHECK(reader.position() == truncated.size());
+        }
+        std::string s(truncated.begin(), truncated.end());
+        std::istringstream is(s);
+        std::error_code ec;
+        cbor::cbor_sequence_reader<json> reader(is);
+        reader.num_threads(2).chunk_size(100);
+        std::size_t count = reader.read([](json&&, std::size_t){}, ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+        CHECK(count == 499);
+        CHECK(reader.position() == truncated.size());
+    }
+
+    SECTION("malformed item")
+    {
+        input.push_back(0x1c);
+        std::vector<uint8_t> more = make_sequence(10);
+        input.insert(input.end(), more.begin(), more.end());
+
+        std::error_code ec;
+        cbor::cbor_sequence_reader<json> reader(input);
+        reader.num_threads(3).chunk_size(256);
+        std::size_t count = reader.read([](json&&, std::size_t){}, ec);
+        CHECK(ec == cbor::cbor_errc::unknown_type);
+        CHECK(count == 500);
+        CHECK(reader.position() == good_size + 1);
+
+        cbor::cbor_sequence_reader<json> reader2(input);
+        REQUIRE_THROWS_AS(reader2.read([](json&&, std::size_t){}), ser_error);
+    }
+
+    SECTION("callback exception stops the workers")
+    {
+        cbor::cbor_sequence_reader<json> reader(input);
+        reader.num_threads(4).chunk_size(64);
+        std::size_t count = 0;
+        REQUIRE_THROWS_AS(reader.read([&](json&&, std::size_t)
+        {
+            if (++count == 10)
+            {
+                JSONCONS_THROW(std::runtime_error("stop"));
+            }
+        }), std::runtime_error);
+        CHECK(count == 10);
+    }
+}
+
+TEST_CASE("cbor_sequence_writer tests")
+{
+    SECTION("items are concatenated")
+    {
+        std::vector<uint8_t> data;
+        {
+            cbor::cbor_bytes_sequence_writer writer(data);
+            writer.write(1);
+            writer.write(std::string("a"));
+            writer.write(json::parse("[true]"));
+            auto& encoder = writer.begin_item();
+            encoder.begin_array(1);
+            encoder.null_value();
+            encoder.end_array();
+        }
+        std::vector<uint8_t> expected = {0x01, 0x61, 0x61, 0x81, 0xf5, 0x81, 0xf6};
+        CHECK(data == expected);
+    }
+
+    SECTION("each item has its own stringref namespace")
+    {
+        std::ostringstream os;
+        {
+            cbor::cbor_stream_sequence_writer writer(os, cbor::cbor_options().pack_strings(true));
+            writer.write(json::parse(R"(["abc","abc"])"));
+            writer.write(json::parse(R"(["abc","abc"])"));
+            writer.flush();
+        }
+        std::string s = os.str();
+        std::vector<uint8_t> data(s.begin(), s.end());
+        std::vector<uint8_t> item = {0xd9, 0x01, 0x00, 0x82, 0x63, 0x61, 0x62, 0x63, 0xd8, 0x19, 0x00};
+        std::vector<uint8_t> expected(item);
+        expected.insert(expected.end(), item.begin(), item.end());
+        CHECK(data == expected);
+    }
+}
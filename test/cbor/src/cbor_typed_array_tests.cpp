@@ -11,6 +11,8 @@
 #include <utility>
 #include <ctime>
 #include <limits>
+#include <algorithm>
+#include <cstring>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -820,3 +822,254 @@ TEST_CASE("cbor typed array tests")
     }
 } 
 
+
+namespace {
+
+    // A CBOR array of padding items followed by a typed array, so that the
+    // typed array payload starts at the given offset, 8 or 9
+    template <class T>
+    std::vector<uint8_t> make_typed_array(uint8_t tag, const std::vector<T>& values, bool big_endian, std::size_t offset)
+    {
+        std::vector<uint8_t> input;
+        input.push_back(offset == 8 ? 0x81 : 0x82);
+        if (offset == 9)
+        {
+            input.push_back(0x00);
+        }
+        const uint32_t length = static_cast<uint32_t>(values.size()*sizeof(T));
+        input.push_back(0xd8);
+        input.push_back(tag);
+        input.push_back(0x5a); // Byte string with a 4 byte length
+        input.push_back(static_cast<uint8_t>(length >> 24));
+        input.push_back(static_cast<uint8_t>(length >> 16));
+        input.push_back(static_cast<uint8_t>(length >> 8));
+        input.push_back(static_cast<uint8_t>(length));
+
+        const bool swap = big_endian != (jsoncons::endian::native == jsoncons::endian::big);
+        for (auto val : values)
+        {
+            uint8_t buf[sizeof(T)];
+            std::memcpy(buf, &val, sizeof(T));
+            if (swap)
+            {
+                std::reverse(buf, buf + sizeof(T));
+            }
+            input.insert(input.end(), buf, buf + sizeof(T));
+        }
+        return input;
+    }
+
+    struct typed_array_recorder : public default_json_visitor
+    {
+        const void* data = nullptr;
+        std::vector<double> values;
+    private:
+        bool visit_typed_array(const span<const double>& s,  
+                               semantic_tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            data = s.data();
+            values.assign(s.begin(), s.end());
+            return true;
+        }
+    };
+
+    template <class T>
+    void check_typed_array_values(uint8_t be_tag, uint8_t le_tag)
+    {
+        std::vector<T> values;
+        for (std::size_t i = 0; i < 1001; ++i)
+        {
+            values.push_back(static_cast<T>(i*37 % 251) - static_cast<T>(i % 3));
+        }
+        for (std::size_t offset = 8; offset <= 9; ++offset)
+        {
+            for (int big_endian = 0; big_endian <= 1; ++big_endian)
+            {
+                std::vector<uint8_t> input = make_typed_array(big_endian ? be_tag : le_tag, values, big_endian != 0, offset);
+                json j = cbor::decode_cbor<json>(input);
+                REQUIRE(j[j.size()-1].size() == values.size());
+                CHECK(j[j.size()-1].as<std::vector<T>>() == values);
+
+                std::string s(input.begin(), input.end());
+                std::istringstream is(s);
+                CHECK(cbor::decode_cbor<json>(is) == j);
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE("cbor typed array views")
+{
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i * 0.5 - 100.0);
+    }
+
+    SECTION("host byte order and aligned is viewed in place")
+    {
+        bool big_endian = jsoncons::endian::native == jsoncons::endian::big;
+        std::vector<uint8_t> input = make_typed_array(big_endian ? 0x52 : 0x56, values, big_endian, 8);
+
+        typed_array_recorder visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        CHECK(visitor.values == values);
+        CHECK(visitor.data == input.data() + 8);
+    }
+
+    SECTION("host byte order and misaligned is copied")
+    {
+        bool big_endian = jsoncons::endian::native == jsoncons::endian::big;
+        std::vector<uint8_t> input = make_typed_array(big_endian ? 0x52 : 0x56, values, big_endian, 9);
+
+        typed_array_recorder visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        CHECK(visitor.values == values);
+        CHECK(visitor.data != input.data() + 9);
+    }
+
+    SECTION("other byte order is swapped")
+    {
+        bool big_endian = jsoncons::endian::native != jsoncons::endian::big;
+        std::vector<uint8_t> input = make_typed_array(big_endian ? 0x52 : 0x56, values, big_endian, 8);
+
+        typed_array_recorder visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        reader.read();
+        CHECK(visitor.values == values);
+        CHECK(visitor.data != input.data() + 8);
+    }
+
+    SECTION("stream source")
+    {
+        std::vector<uint8_t> input = make_typed_array(0x52, values, true, 8);
+        std::string s(input.begin(), input.end());
+        std::istringstream is(s);
+
+        typed_array_recorder visitor;
+        cbor::cbor_stream_reader reader(is, visitor);
+        reader.read();
+        CHECK(visitor.values == values);
+    }
+
+    SECTION("truncated payload")
+    {
+        std::vector<uint8_t> input = make_typed_array(0x56, values, false, 8);
+        input.resize(input.size() - 3);
+
+        typed_array_recorder visitor;
+        cbor::cbor_bytes_reader reader(input, visitor);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+
+    SECTION("element types")
+    {
+        check_typed_array_values<uint16_t>(0x41, 0x45);
+        check_typed_array_values<uint32_t>(0x42, 0x46);
+        check_typed_array_values<uint64_t>(0x43, 0x47);
+        check_typed_array_values<int16_t>(0x49, 0x4d);
+        check_typed_array_values<int32_t>(0x4a, 0x4e);
+        check_typed_array_values<int64_t>(0x4b, 0x4f);
+        check_typed_array_values<float>(0x51, 0x55);
+        check_typed_array_values<double>(0x52, 0x56);
+    }
+}
+
+TEST_CASE("cbor multi_dim_array tests")
+{
+    SECTION("row major classic array")
+    {
+        const std::vector<uint8_t> input = {
+            0xd8,0x28, // Tag 40, multi-dimensional array, row major
+            0x82, // array(2)
+                0x82,0x02,0x03, // shape [2,3]
+                0x86,0x02,0x04,0x08,0x04,0x10,0x19,0x01,0x00 // [2,4,8,4,16,256]
+        };
+
+        auto a = cbor::decode_cbor<cbor::multi_dim_array<uint16_t>>(input);
+        CHECK(a.shape() == std::vector<std::size_t>{2,3});
+        CHECK(a.is_row_major());
+        CHECK(a.strides() == std::vector<std::size_t>{3,1});
+        CHECK(a.values() == std::vector<uint16_t>{2,4,8,4,16,256});
+        CHECK(a({1,2}) == 256);
+        CHECK(a({0,1}) == 4);
+    }
+
+    SECTION("column major typed array")
+    {
+        std::vector<double> values;
+        for (std::size_t i = 0; i < 3*4*5; ++i)
+        {
+            values.push_back(static_cast<double>(i) / 4);
+        }
+        cbor::multi_dim_array<double> a({3,4,5}, values, semantic_tag::multi_dim_column_major);
+        CHECK(a.strides() == std::vector<std::size_t>{1,3,12});
+        CHECK(a({2,1,3}) == values[2 + 1*3 + 3*12]);
+
+        std::vector<uint8_t> buf;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::encode_cbor(a, buf, options);
+        CHECK(buf[0] == 0xd9); // Tag 1040
+        CHECK(buf[1] == 0x04);
+        CHECK(buf[2] == 0x10);
+
+        auto b = cbor::decode_cbor<cbor::multi_dim_array<double>>(buf);
+        CHECK(b == a);
+        CHECK_FALSE(b.is_row_major());
+
+        std::string s(buf.begin(), buf.end());
+        std::istringstream is(s);
+        CHECK(cbor::decode_cbor<cbor::multi_dim_array<double>>(is) == a);
+
+        // Converted in bulk to another element type
+        auto c = cbor::decode_cbor<cbor::multi_dim_array<float>>(buf);
+        CHECK(c.shape() == a.shape());
+        CHECK(c({2,1,3}) == static_cast<float>(a({2,1,3})));
+    }
+
+    SECTION("without typed arrays")
+    {
+        cbor::multi_dim_array<int32_t> a({2,2});
+        a({0,0}) = -1;
+        a({0,1}) = 2;
+        a({1,0}) = -3;
+        a({1,1}) = 4;
+        CHECK(a.values() == std::vector<int32_t>{-1,2,-3,4});
+
+        std::vector<uint8_t> buf;
+        cbor::encode_cbor(a, buf);
+        CHECK(cbor::decode_cbor<cbor::multi_dim_array<int32_t>>(buf) == a);
+    }
+
+    SECTION("one dimensional typed array")
+    {
+        std::vector<float> x = {1.5f, 2.5f, -3.0f};
+        std::vector<uint8_t> buf;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::encode_cbor(x, buf, options);
+
+        auto a = cbor::decode_cbor<cbor::multi_dim_array<float>>(buf);
+        CHECK(a.shape() == std::vector<std::size_t>{3});
+        CHECK(a.values() == x);
+    }
+
+    SECTION("shape does not match the elements")
+    {
+        const std::vector<uint8_t> input = {
+            0xd8,0x28,
+            0x82,
+                0x82,0x02,0x03,
+                0x85,0x02,0x04,0x08,0x04,0x10
+        };
+        CHECK_THROWS_AS(cbor::decode_cbor<cbor::multi_dim_array<uint16_t>>(input), ser_error);
+    }
+}
@@ -387,3 +387,120 @@ TEMPLATE_TEST_CASE("msgpack_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+namespace {
+
+    // Returns the events that follow each member of the root object, skipping 
+    // nested containers with skip() or by stepping through their events with next()
+    std::vector<std::string> events_after_skip(msgpack::msgpack_bytes_cursor& cursor, bool use_skip)
+    {
+        std::vector<std::string> events;
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        while (!cursor.done())
+        {
+            const auto& event = cursor.current();
+            std::ostringstream os;
+            os << event.event_type();
+            if (event.event_type() == staj_event_type::key || event.event_type() == staj_event_type::string_value)
+            {
+                os << " " << event.get<std::string>();
+            }
+            events.push_back(os.str());
+            if (event.event_type() == staj_event_type::begin_object || event.event_type() == staj_event_type::begin_array)
+            {
+                if (use_skip)
+                {
+                    cursor.skip();
+                }
+                else
+                {
+                    int depth = 0;
+                    do
+                    {
+                        auto type = cursor.current().event_type();
+                        if (type == staj_event_type::begin_object || type == staj_event_type::begin_array)
+                        {
+                            ++depth;
+                        }
+                        else if (type == staj_event_type::end_object || type == staj_event_type::end_array)
+                        {
+                            --depth;
+                        }
+                        cursor.next();
+                    }
+                    while (depth > 0);
+                }
+            }
+            else
+            {
+                cursor.next();
+            }
+        }
+        return events;
+    }
+
+} // namespace
+
+TEST_CASE("msgpack_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "a" : [1, [2, "three"], {"x" : 1.5, "y" : -1000000, "z" : 4294967296}],
+        "b" : {"c" : {"d" : [true, null, false]}, "e" : "a text string that is longer than thirty one bytes"},
+        "f" : -7,
+        "h" : [],
+        "i" : {},
+        "j" : "a text string that is longer than thirty one bytes"
+    }
+    )");
+    j["g"] = ojson(byte_string_arg, std::vector<uint8_t>{1,2,3,4,5});
+    j["k"] = ojson(byte_string_arg, std::vector<uint8_t>(300, 7));
+    j["l"] = ojson(1609459200, semantic_tag::epoch_second);
+    j["m"] = ojson(json_array_arg);
+    for (int i = 0; i < 20; ++i)
+    {
+        j["m"].push_back(ojson(json_object_arg, {{"n", ojson(i * 1000)}, {"s", ojson(std::string(i * 20, 'x'))}}));
+    }
+    ojson big(json_object_arg);
+    for (int i = 0; i < 20; ++i)
+    {
+        big.insert_or_assign(std::to_string(i), ojson(-i * 100000));
+    }
+    j["n"] = big;
+
+    std::vector<uint8_t> data;
+    msgpack::encode_msgpack(j, data);
+
+    SECTION("compare with next")
+    {
+        msgpack::msgpack_bytes_cursor cursor1(data);
+        msgpack::msgpack_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 23);
+    }
+
+    SECTION("ext types")
+    {
+        // {"a": [fixext1, fixext4 timestamp, ext8], "b": 1}
+        std::vector<uint8_t> bytes = {0x82,
+                                      0xa1,'a',0x93,0xd4,0x01,0x05,0xd6,0xff,0x00,0x00,0x00,0x01,0xc7,0x02,0x03,0x01,0x02,
+                                      0xa1,'b',0x01};
+        msgpack::msgpack_bytes_cursor cursor1(bytes);
+        msgpack::msgpack_bytes_cursor cursor2(bytes);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 5);
+    }
+
+    SECTION("unexpected eof")
+    {
+        std::vector<uint8_t> bytes = {0x92,0x93,0x01,0xa5,'a'};
+        msgpack::msgpack_bytes_cursor cursor(bytes);
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == msgpack::msgpack_errc::unexpected_eof);
+    }
+}
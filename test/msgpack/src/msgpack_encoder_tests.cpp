@@ -186,3 +186,127 @@ TEMPLATE_TEST_CASE("test_msgpack_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.bytes2() == expected_full);
 }
+
+TEST_CASE("msgpack_encoder containers of unknown length")
+{
+    std::string big = "[";
+    for (int i = 0; i < 70000; ++i)
+    {
+        if (i > 0)
+        {
+            big.push_back(',');
+        }
+        big += std::to_string(i % 300);
+    }
+    big += "]";
+
+    std::vector<std::string> inputs = {
+        R"({"a":1,"b":[true,false,null],"c":{"d":"e"}})",
+        R"([[],{},[[[1]]],{"x":{"y":{}}}])",
+        R"({"k1":1,"k2":2,"k3":3,"k4":4,"k5":5,"k6":6,"k7":7,"k8":8,"k9":9,"k10":10,"k11":11,"k12":12,"k13":13,"k14":14,"k15":15,"k16":16})",
+        R"([0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,{"a":[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]}])",
+        "\"not a container\"",
+        big
+    };
+
+    SECTION("length required by default")
+    {
+        std::vector<uint8_t> v;
+        msgpack::msgpack_bytes_encoder encoder(v);
+        REQUIRE_THROWS_WITH(encoder.begin_object(), msgpack::msgpack_error_category_impl().message((int)msgpack::msgpack_errc::object_length_required).c_str());
+        REQUIRE_THROWS_WITH(encoder.begin_array(), msgpack::msgpack_error_category_impl().message((int)msgpack::msgpack_errc::array_length_required).c_str());
+    }
+
+    SECTION("backpatched")
+    {
+        for (const auto& input : inputs)
+        {
+            std::vector<uint8_t> v;
+            {
+                msgpack::msgpack_bytes_encoder encoder(v, msgpack::msgpack_options().backpatch_lengths(true));
+                json_string_reader reader(input, encoder);
+                reader.read();
+            }
+            json expected = json::parse(input);
+            CHECK(msgpack::decode_msgpack<json>(v) == expected);
+            if (expected.is_object())
+            {
+                CHECK(v[0] == msgpack::msgpack_type::map32_type);
+            }
+            else if (expected.is_array())
+            {
+                CHECK(v[0] == msgpack::msgpack_type::array32_type);
+            }
+        }
+    }
+
+    SECTION("compacted")
+    {
+        for (const auto& input : inputs)
+        {
+            std::ostringstream os;
+            {
+                msgpack::msgpack_stream_encoder encoder(os, msgpack::msgpack_options().backpatch_lengths(true).compact_lengths(true));
+                json_string_reader reader(input, encoder);
+                reader.read();
+            }
+            std::string s = os.str();
+            std::vector<uint8_t> v(s.begin(), s.end());
+
+            std::vector<uint8_t> expected;
+            msgpack::encode_msgpack(ojson::parse(input), expected);
+            CHECK(v == expected);
+        }
+    }
+
+    SECTION("mixed with known lengths")
+    {
+        std::vector<uint8_t> v;
+        msgpack::msgpack_bytes_encoder encoder(v, msgpack::msgpack_options().backpatch_lengths(true).compact_lengths(true));
+        encoder.begin_array(2);
+        encoder.begin_object();
+        encoder.key("a");
+        encoder.begin_array(1);
+        encoder.begin_array();
+        encoder.uint64_value(1);
+        encoder.uint64_value(2);
+        encoder.end_array();
+        encoder.end_array();
+        encoder.end_object();
+        // The object's bytes are passed on when it ends
+        CHECK(v.size() == 8);
+        encoder.begin_array();
+        encoder.end_array();
+        encoder.end_array();
+        encoder.flush();
+
+        std::vector<uint8_t> expected = {0x92, 0x81, 0xa1, 'a', 0x91, 0x92, 0x01, 0x02, 0x90};
+        CHECK(v == expected);
+    }
+
+    SECTION("too few items inside a container of unknown length")
+    {
+        std::vector<uint8_t> v;
+        msgpack::msgpack_bytes_encoder encoder(v, msgpack::msgpack_options().backpatch_lengths(true));
+        encoder.begin_array();
+        encoder.begin_array(2);
+        encoder.null_value();
+        REQUIRE_THROWS_WITH(encoder.end_array(), msgpack::msgpack_error_category_impl().message((int)msgpack::msgpack_errc::too_few_items).c_str());
+    }
+
+    SECTION("reset discards the buffered bytes")
+    {
+        std::vector<uint8_t> v;
+        msgpack::msgpack_bytes_encoder encoder(v, msgpack::msgpack_options().backpatch_lengths(true).compact_lengths(true));
+        encoder.begin_object();
+        encoder.key("a");
+        encoder.reset();
+        encoder.begin_array();
+        encoder.bool_value(true);
+        encoder.end_array();
+        encoder.flush();
+
+        std::vector<uint8_t> expected = {0x91, 0xc3};
+        CHECK(v == expected);
+    }
+}
@@ -0,0 +1,153 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_json.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <cstdint>
+
+using namespace jsoncons;
+
+TEST_CASE("json_arena tests")
+{
+    SECTION("alignment")
+    {
+        json_arena arena(64);
+        void* p1 = arena.allocate(1, 1);
+        void* p2 = arena.allocate(8, 8);
+        void* p3 = arena.allocate(100, 16);
+        CHECK(p1 != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(p2) % 8 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(p3) % 16 == 0);
+        CHECK(arena.bytes_allocated() == 109);
+        CHECK(arena.bytes_reserved() > 0);
+
+        arena.release();
+        CHECK(arena.bytes_allocated() == 0);
+        CHECK(arena.bytes_reserved() == 0);
+    }
+
+    SECTION("initial buffer")
+    {
+        alignas(16) char buffer[256];
+        json_arena arena(buffer, sizeof(buffer));
+        char* p = static_cast<char*>(arena.allocate(32, 8));
+        CHECK(p >= buffer);
+        CHECK(p < buffer + sizeof(buffer));
+        CHECK(arena.bytes_reserved() == 0);
+
+        arena.allocate(512, 8);
+        CHECK(arena.bytes_reserved() > 0);
+    }
+}
+
+TEST_CASE("arena_allocator tests")
+{
+    json_arena arena1;
+    json_arena arena2;
+
+    arena_allocator<char> a1(arena1);
+    arena_allocator<int> b1(a1);
+    arena_allocator<char> a2(arena2);
+
+    CHECK(a1 == b1);
+    CHECK(a1 != a2);
+    CHECK(b1.arena() == &arena1);
+    CHECK(arena_allocator<char>() != a1);
+}
+
+TEST_CASE("arena_json decode tests")
+{
+    std::string input = R"(
+    {
+        "name" : "A string that is too long for a short string",
+        "values" : [1, 2.5, true, null, "Another string that is too long"],
+        "nested" : {"key" : "value", "list" : [[1],[2],[3]]}
+    }
+    )";
+
+    SECTION("decode from string")
+    {
+        json_arena arena;
+        auto j = decode_json<arena_json>(arena, input);
+
+        CHECK(arena.bytes_allocated() > 0);
+        CHECK(j.get_allocator().arena() == &arena);
+        CHECK(j.at("name").as<std::string>() == "A string that is too long for a short string");
+        CHECK(j.at("values").size() == 5);
+        CHECK(j.at("values")[1].as<double>() == 2.5);
+        CHECK(j.at("nested").at("list")[2][0].as<int>() == 3);
+        CHECK(j == arena_json::parse(input));
+    }
+
+    SECTION("decode from stream")
+    {
+        json_arena arena;
+        std::istringstream is(input);
+        auto j = decode_json<arena_ojson>(arena, is);
+
+        CHECK(j.get_allocator().arena() == &arena);
+        CHECK(j.at("nested").at("key").as<std::string>() == "value");
+        CHECK(j.object_range().begin()->key() == "name");
+    }
+
+    SECTION("copies stay in the arena")
+    {
+        json_arena arena;
+        auto j = decode_json<arena_json>(arena, input);
+        std::size_t before = arena.bytes_allocated();
+
+        arena_json copy(j);
+        CHECK(arena.bytes_allocated() > before);
+        CHECK(copy.get_allocator().arena() == &arena);
+        CHECK(copy == j);
+
+        arena_json moved(std::move(copy));
+        CHECK(moved.get_allocator().arena() == &arena);
+    }
+
+    SECTION("parse error")
+    {
+        json_arena arena;
+        REQUIRE_THROWS_AS(decode_json<arena_json>(arena, std::string("[1,2")), ser_error);
+    }
+}
+
+TEST_CASE("arena_json_document tests")
+{
+    std::string input = R"({"id" : 1001, "tags" : ["a","b"], "owner" : {"name" : "A name longer than a short string"}})";
+
+    SECTION("parse")
+    {
+        auto doc = arena_json_document::parse(input);
+        CHECK(doc.root().at("id").as<int>() == 1001);
+        CHECK(doc.root().at("owner").at("name").as<std::string>() == "A name longer than a short string");
+        CHECK(doc.arena().bytes_allocated() > 0);
+    }
+
+    SECTION("modify with the document allocator")
+    {
+        arena_ojson_document doc;
+        CHECK(doc.root().is_null());
+
+        doc.root() = arena_ojson(json_object_arg, semantic_tag::none, doc.get_allocator());
+        doc.root().try_emplace("first", arena_ojson("A value longer than a short string", doc.get_allocator()));
+        doc.root().try_emplace("second", 2);
+        CHECK(doc.root().size() == 2);
+        CHECK(doc.root().get_allocator() == doc.get_allocator());
+        CHECK(doc.root().at("first").get_allocator() == doc.get_allocator());
+    }
+
+    SECTION("move and clear")
+    {
+        auto doc = arena_json_document::parse(input);
+        arena_json_document other(std::move(doc));
+        CHECK(other.root().at("tags").size() == 2);
+
+        other.clear();
+        CHECK(other.root().is_null());
+        CHECK(other.arena().bytes_reserved() > 0);
+    }
+}
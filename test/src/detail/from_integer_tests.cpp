@@ -3,13 +3,111 @@
 
 #include <jsoncons/json.hpp>
 #include <catch/catch.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace jsoncons;
 
+namespace {
+
+    template <class Integer>
+    void check_from_integer(Integer value)
+    {
+        std::ostringstream os;
+        os << +value;
+
+        std::string s;
+        std::size_t length = jsoncons::detail::from_integer(value, s);
+        CHECK(s == os.str());
+        CHECK(length == s.size());
+
+        // A result without append
+        std::vector<char> v;
+        jsoncons::detail::from_integer(value, v);
+        CHECK(std::string(v.begin(), v.end()) == os.str());
+
+        std::wstring ws;
+        jsoncons::detail::from_integer(value, ws);
+        CHECK(ws == std::wstring(s.begin(), s.end()));
+    }
+
+}
+
 TEST_CASE("detail::from_integer tests")
 {
-    SECTION("")
+    SECTION("limits")
+    {
+        check_from_integer((std::numeric_limits<int64_t>::min)());
+        check_from_integer((std::numeric_limits<int64_t>::max)());
+        check_from_integer((std::numeric_limits<uint64_t>::max)());
+        check_from_integer((std::numeric_limits<int32_t>::min)());
+        check_from_integer((std::numeric_limits<int8_t>::min)());
+        check_from_integer((std::numeric_limits<uint8_t>::max)());
+        check_from_integer((std::numeric_limits<int16_t>::min)());
+        check_from_integer(int64_t(0));
+        check_from_integer(uint64_t(0));
+        check_from_integer(int(-1));
+    }
+
+    SECTION("powers of ten and their neighbours")
+    {
+        uint64_t p = 1;
+        for (int i = 0; i < 20; ++i)
+        {
+            check_from_integer(p);
+            check_from_integer(p - 1);
+            check_from_integer(p + 1);
+            check_from_integer(-static_cast<int64_t>(p / 2) - 1);
+            if (i < 19)
+            {
+                p *= 10;
+            }
+        }
+    }
+
+    SECTION("random")
     {
+        std::mt19937_64 gen(20);
+        for (int i = 0; i < 10000; ++i)
+        {
+            uint64_t u = gen() >> (gen() % 64);
+            check_from_integer(u);
+            check_from_integer(static_cast<int64_t>(u) * ((i % 2 == 0) ? 1 : -1));
+        }
+    }
+
+    SECTION("appends")
+    {
+        std::string s = "x=";
+        jsoncons::detail::from_integer(-42, s);
+        CHECK(s == "x=-42");
     }
 }
 
+TEST_CASE("bigint::write_string chunks")
+{
+    std::vector<std::string> inputs;
+    std::string digits = "1";
+    for (std::size_t n = 1; n <= 80; ++n)
+    {
+        inputs.push_back(digits);
+        inputs.push_back(std::string(n, '9'));
+        inputs.push_back("1" + std::string(n, '0') + "1");
+        digits.push_back(static_cast<char>('0' + n % 10));
+    }
+
+    for (const auto& input : inputs)
+    {
+        CHECK(bigint::from_string(input).to_string() == input);
+        CHECK(bigint::from_string("-" + input).to_string() == "-" + input);
+    }
+    CHECK(bigint::from_string("0").to_string() == "0");
+
+    std::string s = "x=";
+    bigint::from_string("-123456789012345678901234567890").write_string(s);
+    CHECK(s == "x=-123456789012345678901234567890");
+}
@@ -0,0 +1,474 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/simd.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("detail::find_string_special tests")
+{
+    SECTION("empty")
+    {
+        std::string s;
+        CHECK(jsoncons::detail::find_string_special(s.data(), s.data()+s.size()) == s.data());
+    }
+    SECTION("special character at each offset")
+    {
+        const char specials[] = {'\"', '\\', '\n', '\x01', '\x1f'};
+        for (char special : specials)
+        {
+            for (std::size_t len = 1; len <= 100; ++len)
+            {
+                for (std::size_t i = 0; i < len; ++i)
+                {
+                    std::string s(len, 'a');
+                    s[i] = special;
+                    const char* p = jsoncons::detail::find_string_special(s.data(), s.data()+s.size());
+                    REQUIRE(p == s.data()+i);
+                }
+            }
+        }
+    }
+    SECTION("non-ascii and space are not special")
+    {
+        std::string s = "\xc3\xa9\x20\x7f\x80\xff\xe2\x82\xac abcdefghijklmnopqrstuvwxyz0123456789";
+        CHECK(jsoncons::detail::find_string_special(s.data(), s.data()+s.size()) == s.data()+s.size());
+    }
+    SECTION("agrees with scalar")
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, 255);
+        for (std::size_t n = 0; n < 1000; ++n)
+        {
+            std::string s;
+            std::size_t len = static_cast<std::size_t>(dist(gen));
+            for (std::size_t i = 0; i < len; ++i)
+            {
+                int c = dist(gen);
+                s.push_back(static_cast<char>(c < 0x20 && dist(gen) < 240 ? 'x' : c));
+            }
+            const char* first = s.data();
+            const char* last = s.data()+s.size();
+            CHECK(jsoncons::detail::find_string_special(first, last) ==
+                  jsoncons::detail::find_string_special_scalar(first, last));
+        }
+    }
+}
+
+TEST_CASE("parse long strings")
+{
+    SECTION("escapes at various offsets")
+    {
+        for (std::size_t len = 0; len < 80; ++len)
+        {
+            std::string expected(len, 'a');
+            std::string input = "\"" + expected + "\\n" + expected + "\"";
+            json j = json::parse(input);
+            REQUIRE(j.as_string() == expected + "\n" + expected);
+        }
+    }
+    SECTION("control character after long run")
+    {
+        std::string input = "\"" + std::string(70, 'a') + "\x01\"";
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::illegal_control_character);
+        CHECK(reader.column() == 73);
+    }
+    SECTION("multibyte utf8")
+    {
+        std::string value;
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            value.append("\xe6\x97\xa5\xd1\x88");
+        }
+        json j = json::parse("[\"" + value + "\"]");
+        CHECK(j[0].as_string() == value);
+    }
+}
+
+TEST_CASE("detail::find_char_to_escape tests")
+{
+    const char specials[] = {'\"', '\\', '\x00', '\x1f', '\x7f', '/', '\x80', '\xff'};
+    for (int options_index = 0; options_index < 4; ++options_index)
+    {
+        bool escape_all_non_ascii = (options_index & 1) != 0;
+        bool escape_solidus = (options_index & 2) != 0;
+        for (std::size_t len = 1; len <= 70; ++len)
+        {
+            for (std::size_t i = 0; i < len; ++i)
+            {
+                for (char special : specials)
+                {
+                    std::string s(len, 'a');
+                    s[i] = special;
+                    const char* expected = jsoncons::detail::find_char_to_escape_scalar(s.data(), s.data()+len, escape_all_non_ascii, escape_solidus);
+                    const char* p = jsoncons::detail::find_char_to_escape(s.data(), s.data()+len, escape_all_non_ascii, escape_solidus);
+                    REQUIRE(p == expected);
+                    bool escaped = special != '/' ? (special != '\x80' && special != '\xff') || escape_all_non_ascii : escape_solidus;
+                    REQUIRE(p == (escaped ? s.data()+i : s.data()+len));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("detail::find_non_ascii tests")
+{
+    for (std::size_t len = 1; len <= 70; ++len)
+    {
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            std::string s(len, 'a');
+            s[i] = '\x80';
+            const char* p = jsoncons::detail::find_non_ascii(s.data(), s.data()+s.size());
+            REQUIRE(p == s.data()+i);
+        }
+        std::string s(len, '\x7f');
+        CHECK(jsoncons::detail::find_non_ascii(s.data(), s.data()+s.size()) == s.data()+s.size());
+    }
+}
+
+TEST_CASE("detail::find_non_ascii wide tests")
+{
+    for (std::size_t len = 1; len <= 40; ++len)
+    {
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            std::u16string u16(len, u'a');
+            u16[i] = 0x100;
+            CHECK(jsoncons::detail::find_non_ascii(u16.data(), u16.data()+len) == u16.data()+i);
+            u16[i] = 0x80;
+            CHECK(jsoncons::detail::find_non_ascii(u16.data(), u16.data()+len) == u16.data()+i);
+
+            std::u32string u32(len, U'a');
+            u32[i] = 0x10000;
+            CHECK(jsoncons::detail::find_non_ascii(u32.data(), u32.data()+len) == u32.data()+i);
+            u32[i] = 0x80;
+            CHECK(jsoncons::detail::find_non_ascii(u32.data(), u32.data()+len) == u32.data()+i);
+
+            std::wstring w(len, L'a');
+            w[i] = static_cast<wchar_t>(-1);
+            CHECK(jsoncons::detail::find_non_ascii(w.data(), w.data()+len) == w.data()+i);
+        }
+        std::u32string u32(len, U'\x7f');
+        CHECK(jsoncons::detail::find_non_ascii(u32.data(), u32.data()+len) == u32.data()+len);
+    }
+}
+
+TEST_CASE("detail::copy_ascii tests")
+{
+    for (std::size_t len = 0; len <= 40; ++len)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            s.push_back(static_cast<char>(i % 128));
+        }
+        std::u16string u16(len, u'x');
+        jsoncons::detail::copy_ascii(s.data(), s.data()+len, &u16[0]);
+        CHECK(u16 == std::u16string(s.begin(), s.end()));
+        std::u32string u32(len, U'x');
+        jsoncons::detail::copy_ascii(s.data(), s.data()+len, &u32[0]);
+        CHECK(u32 == std::u32string(s.begin(), s.end()));
+
+        std::string t(len, 'x');
+        jsoncons::detail::copy_ascii(u16.data(), u16.data()+len, &t[0]);
+        CHECK(t == s);
+        std::string v(len, 'x');
+        jsoncons::detail::copy_ascii(u32.data(), u32.data()+len, &v[0]);
+        CHECK(v == s);
+    }
+}
+
+TEST_CASE("detail::byte_swap_copy tests")
+{
+    std::vector<uint8_t> input(8*70 + 3);
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<uint8_t>(i*7 + 1);
+    }
+    for (std::size_t width = 1; width <= 8; width *= 2)
+    {
+        for (std::size_t count = 0; count <= 70; ++count)
+        {
+            // Unaligned source and destination
+            std::vector<uint8_t> out(count*width + 1, 0);
+            jsoncons::detail::byte_swap_copy(input.data() + 3, count, width, out.data() + 1);
+
+            std::vector<uint8_t> expected(count*width + 1, 0);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (std::size_t k = 0; k < width; ++k)
+                {
+                    expected[1 + i*width + k] = input[3 + i*width + width - 1 - k];
+                }
+            }
+            CHECK(out == expected);
+
+            // In place
+            std::vector<uint8_t> buf(input.begin() + 3, input.begin() + 3 + count*width);
+            jsoncons::detail::byte_swap_copy(buf.data(), count, width, buf.data());
+            CHECK(std::equal(buf.begin(), buf.end(), expected.begin() + 1));
+        }
+    }
+}
+
+TEST_CASE("detail::classify_json_block tests")
+{
+    std::mt19937 gen(42);
+    const char alphabet[] = "{}[]:,\" \t\n\r\\ab0[{}]\x80\xff\x1b\x5b\x7b\x5d\x7d\x1a";
+    std::uniform_int_distribution<std::size_t> dist(0, sizeof(alphabet) - 2);
+    for (std::size_t n = 0; n < 1000; ++n)
+    {
+        char block[64];
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            block[i] = alphabet[dist(gen)];
+        }
+        jsoncons::detail::json_block_masks expected;
+        jsoncons::detail::classify_json_block_scalar(block, expected);
+        jsoncons::detail::json_block_masks actual;
+        jsoncons::detail::classify_json_block(block, actual);
+        CHECK(actual.quote == expected.quote);
+        CHECK(actual.backslash == expected.backslash);
+        CHECK(actual.structural == expected.structural);
+        CHECK(actual.whitespace == expected.whitespace);
+    }
+}
+
+TEST_CASE("detail::prefix_xor tests")
+{
+    CHECK(jsoncons::detail::prefix_xor(0) == 0);
+    CHECK(jsoncons::detail::prefix_xor(1) == ~uint64_t(0));
+    CHECK(jsoncons::detail::prefix_xor((uint64_t(1) << 3) | (uint64_t(1) << 7)) == uint64_t(0x78));
+}
+
+namespace {
+
+    // Validates one code point at a time, as unicode_traits::validate did before
+    // it used skip_valid_utf8
+    unicode_traits::convert_result<char> validate_utf8_reference(const char* data, std::size_t length)
+    {
+        const char* last = data + length;
+        while (data != last) 
+        {
+            std::size_t len = static_cast<std::size_t>(unicode_traits::trailing_bytes_for_utf8[static_cast<uint8_t>(*data)]) + 1;
+            if (len > (std::size_t)(last - data))
+            {
+                return unicode_traits::convert_result<char>{data, unicode_traits::conv_errc::source_exhausted};
+            }
+            unicode_traits::conv_errc result = unicode_traits::is_legal_utf8(data, len);
+            if (result != unicode_traits::conv_errc())
+            {
+                return unicode_traits::convert_result<char>{data, result};
+            }
+            data += len;
+        }
+        return unicode_traits::convert_result<char>{data, unicode_traits::conv_errc()};
+    }
+
+    void check_validate(const std::string& s)
+    {
+        auto expected = validate_utf8_reference(s.data(), s.size());
+        auto actual = unicode_traits::validate(s.data(), s.size());
+        REQUIRE(actual.ptr == expected.ptr);
+        REQUIRE(actual.ec == expected.ec);
+    }
+
+}
+
+TEST_CASE("unicode_traits::validate tests")
+{
+    const std::string valid[] = {"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\x9f\xbf", "\xee\x80\x80", "\xf4\x8f\xbf\xbf", "\xc2\x80", "\xe0\xa0\x80", "\xf0\x90\x80\x80"};
+    const std::string invalid[] = {"\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xc3", "\xc3\x41", "\xe2\x82", "\xe2\x28\xa1", "\xe0\x80\x80", "\xe0\x9f\xbf", 
+                                   "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xf8\x88\x80\x80\x80", 
+                                   "\xff", "\xfe", "\xf0\x9f\x98", "\xc3\xa9\xa9"};
+
+    SECTION("valid sequences at each offset")
+    {
+        for (const auto& seq : valid)
+        {
+            for (std::size_t offset = 0; offset < 70; ++offset)
+            {
+                std::string s = std::string(offset, 'a') + seq + std::string(70 - offset, 'b');
+                auto result = unicode_traits::validate(s.data(), s.size());
+                REQUIRE(result.ec == unicode_traits::conv_errc());
+                REQUIRE(result.ptr == s.data() + s.size());
+                check_validate(s);
+            }
+        }
+    }
+
+    SECTION("invalid sequences at each offset")
+    {
+        for (const auto& seq : invalid)
+        {
+            for (std::size_t offset = 0; offset < 70; ++offset)
+            {
+                std::string s = std::string(offset, 'a') + seq + std::string(70 - offset, 'b');
+                CHECK(unicode_traits::validate(s.data(), s.size()).ec != unicode_traits::conv_errc());
+                check_validate(s);
+                // Preceded by multi-byte characters and at the end of the input
+                std::string t;
+                while (t.size() < offset)
+                {
+                    t += "\xe2\x82\xac";
+                }
+                check_validate(t + seq);
+                check_validate(t + seq + std::string(offset, '\xc3'));
+            }
+        }
+    }
+
+    SECTION("skip_valid_utf8 stops near the end of valid input")
+    {
+        const std::string texts[] = {"ascii text ", "caf\xc3\xa9 na\xc3\xafve \xe2\x82\xac 10 ", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xf0\x9f\x98\x80"};
+        for (const auto& text : texts)
+        {
+            std::string s;
+            while (s.size() < 1000)
+            {
+                s += text;
+            }
+            const char* p = jsoncons::detail::skip_valid_utf8(s.data(), s.data() + s.size());
+            CHECK(p >= s.data());
+            if (jsoncons::detail::cpu_supports_avx2())
+            {
+                CHECK((s.data() + s.size()) - p <= 35);
+            }
+            check_validate(s);
+        }
+    }
+
+    SECTION("agrees with the reference")
+    {
+        std::mt19937 gen(42);
+        const std::string pieces[] = {"a", "bcdefghijklmnopq", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\x9f\xbf", 
+                                      "\x80", "\xc3", "\xe2\x82", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff", "\xc0\xaf"};
+        std::uniform_int_distribution<std::size_t> piece_dist(0, 5);
+        std::uniform_int_distribution<std::size_t> bad_dist(0, 12);
+        std::uniform_int_distribution<int> len_dist(0, 200);
+        for (std::size_t n = 0; n < 3000; ++n)
+        {
+            std::string s;
+            int len = len_dist(gen);
+            for (int i = 0; i < len; ++i)
+            {
+                // Mostly valid, with an occasional invalid piece
+                s += pieces[(i % 50 == 49) ? bad_dist(gen) : piece_dist(gen)];
+            }
+            check_validate(s);
+        }
+    }
+}
+
+namespace {
+
+    // Compares the bulk paths of unicode_traits::convert with the one code point at a 
+    // time path, which is taken for unsigned char sources and vector targets
+    template <class CharT>
+    void check_convert_from_utf8(const std::string& s, unicode_traits::conv_flags flags)
+    {
+        std::basic_string<CharT> actual;
+        auto r = unicode_traits::convert(s.data(), s.size(), actual, flags);
+
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(s.data());
+        std::vector<CharT> expected;
+        auto q = unicode_traits::convert(bytes, s.size(), expected, flags);
+
+        REQUIRE(r.ec == q.ec);
+        REQUIRE((r.ptr - s.data()) == (q.ptr - bytes));
+        REQUIRE(actual == std::basic_string<CharT>(expected.begin(), expected.end()));
+    }
+
+    template <class CharT>
+    void check_round_trip(const std::string& s)
+    {
+        std::basic_string<CharT> wide;
+        auto r = unicode_traits::convert(s.data(), s.size(), wide);
+        REQUIRE(r.ec == unicode_traits::conv_errc());
+
+        std::string narrow;
+        auto q = unicode_traits::convert(wide.data(), wide.size(), narrow);
+        REQUIRE(q.ec == unicode_traits::conv_errc());
+        REQUIRE(q.ptr == wide.data() + wide.size());
+        REQUIRE(narrow == s);
+
+        std::vector<char> expected;
+        unicode_traits::convert(wide.data(), wide.size(), expected);
+        REQUIRE(std::string(expected.begin(), expected.end()) == s);
+    }
+
+}
+
+TEST_CASE("unicode_traits::convert bulk tests")
+{
+    const std::string pieces[] = {"a", "bcdefghijklmnopqrstuvwxyz0123456789", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\x9f\xbf", "\xe6\x97\xa5",
+                                  "\x80", "\xc3", "\xe2\x82", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff", "\xc0\xaf"};
+
+    SECTION("utf8 to utf16 and utf32 agree with the scalar path")
+    {
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<std::size_t> piece_dist(0, 6);
+        std::uniform_int_distribution<std::size_t> bad_dist(0, 13);
+        std::uniform_int_distribution<int> len_dist(0, 150);
+        for (std::size_t n = 0; n < 2000; ++n)
+        {
+            std::string s;
+            int len = len_dist(gen);
+            for (int i = 0; i < len; ++i)
+            {
+                s += pieces[(i % 40 == 39) ? bad_dist(gen) : piece_dist(gen)];
+            }
+            check_convert_from_utf8<char16_t>(s, unicode_traits::conv_flags::strict);
+            check_convert_from_utf8<char32_t>(s, unicode_traits::conv_flags::strict);
+            check_convert_from_utf8<wchar_t>(s, unicode_traits::conv_flags::strict);
+            check_convert_from_utf8<char16_t>(s, unicode_traits::conv_flags::lenient);
+            check_convert_from_utf8<char32_t>(s, unicode_traits::conv_flags::lenient);
+        }
+    }
+
+    SECTION("round trip")
+    {
+        for (std::size_t i = 0; i < 7; ++i)
+        {
+            std::string s;
+            for (std::size_t j = 0; s.size() < 300; ++j)
+            {
+                s += pieces[(i + j) % 7];
+                check_round_trip<char16_t>(s);
+                check_round_trip<char32_t>(s);
+                check_round_trip<wchar_t>(s);
+            }
+        }
+    }
+
+    SECTION("utf16 and utf32 errors after ascii runs")
+    {
+        for (std::size_t offset = 0; offset < 40; ++offset)
+        {
+            std::u16string u16 = std::u16string(offset, u'a') + char16_t(0xD800) + u"bc";
+            std::string narrow;
+            auto r = unicode_traits::convert(u16.data(), u16.size(), narrow);
+            CHECK(r.ec == unicode_traits::conv_errc::unpaired_high_surrogate);
+            CHECK(r.ptr == u16.data() + offset);
+            CHECK(narrow == std::string(offset, 'a'));
+
+            std::u32string u32 = std::u32string(offset, U'a') + char32_t(0xDC00) + U"bc";
+            narrow.clear();
+            auto q = unicode_traits::convert(u32.data(), u32.size(), narrow);
+            CHECK(q.ec == unicode_traits::conv_errc::illegal_surrogate_value);
+            CHECK(q.ptr == u32.data() + offset);
+            CHECK(narrow == std::string(offset, 'a'));
+        }
+    }
+}
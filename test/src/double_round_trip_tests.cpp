@@ -7,6 +7,9 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <cstring>
+#include <cmath>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -43,3 +46,59 @@ TEST_CASE("test_round_trip")
     }
 }
 
+
+TEST_CASE("test random round trip")
+{
+    std::mt19937_64 gen(42);
+
+    SECTION("random bit patterns")
+    {
+        for (std::size_t i = 0; i < 100000; ++i)
+        {
+            uint64_t bits = gen();
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            if (!std::isfinite(d))
+            {
+                continue;
+            }
+            std::string s;
+            json(d).dump(s);
+            double val = json::parse(s).as<double>();
+            REQUIRE(std::memcmp(&val, &d, sizeof(d)) == 0);
+        }
+    }
+    SECTION("shortest")
+    {
+        // No representation with fewer digits rounds back to the same value
+        std::uniform_real_distribution<double> dist(-1e6, 1e6);
+        char buffer[64];
+        for (std::size_t i = 0; i < 10000; ++i)
+        {
+            double d = dist(gen);
+            std::string s;
+            json(d).dump(s);
+            std::string digits;
+            for (char c : s)
+            {
+                if (c == 'e')
+                {
+                    break;
+                }
+                if ((c >= '1' && c <= '9') || (c == '0' && !digits.empty()))
+                {
+                    digits.push_back(c);
+                }
+            }
+            while (!digits.empty() && digits.back() == '0')
+            {
+                digits.pop_back();
+            }
+            if (digits.size() >= 2)
+            {
+                snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(digits.size()) - 2, d);
+                CHECK(json::parse(buffer).as<double>() != d);
+            }
+        }
+    }
+}
@@ -56,7 +56,7 @@ static void check_dtoa(double x, const std::vector<std::string>& expected)
     check_safe_dtoa(x,expected);
 }
 
-TEST_CASE("test grisu3")
+TEST_CASE("test dtoa_general")
 {
     check_dtoa(1.0e100, {"1e+100"});
     check_dtoa(1.0e-100, {"1e-100"});
@@ -98,3 +98,43 @@ TEST_CASE("test grisu3")
     check_dtoa(0.000071, {"7.1e-05"}); 
 }
 
+
+TEST_CASE("test dtoa_general shortest")
+{
+    check_dtoa(1.7976931348623157e308, {"1.7976931348623157e+308"});
+    check_dtoa(2.2250738585072014e-308, {"2.2250738585072014e-308"});
+    check_dtoa(9007199254740993.0, {"9007199254740992.0"});
+    check_dtoa(1e23, {"1e+23"});
+    check_dtoa(0.3, {"0.3"});
+    check_dtoa(123456789012345680.0, {"1.2345678901234568e+17"});
+    check_dtoa(8.41e21, {"8.41e+21"});
+
+    std::string s;
+    REQUIRE(jsoncons::detail::dtoa_general(5e-324, '.', s));
+    CHECK(s == "5e-324");
+}
+
+TEST_CASE("test dtoa_scientific and dtoa_fixed")
+{
+    SECTION("scientific")
+    {
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_scientific(1234.5, '.', s));
+        CHECK(s == "1.2345e+03");
+        s.clear();
+        REQUIRE(jsoncons::detail::dtoa_scientific(-0.001, '.', s));
+        CHECK(s == "-1e-03");
+        s.clear();
+        REQUIRE(jsoncons::detail::dtoa_scientific(42.229999999999997, '.', s));
+        CHECK(s == "4.223e+01");
+    }
+    SECTION("fixed")
+    {
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_fixed(1e-7, '.', s));
+        CHECK(s == "0.0000001");
+        s.clear();
+        REQUIRE(jsoncons::detail::dtoa_fixed(1.5e20, '.', s));
+        CHECK(s == "150000000000000000000.0");
+    }
+}
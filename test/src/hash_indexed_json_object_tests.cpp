@@ -0,0 +1,188 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+using hjson = basic_json<char,hash_indexed_policy>;
+
+namespace {
+
+    template <class J1,class J2>
+    void check_same_members(const J1& j1, const J2& j2)
+    {
+        REQUIRE(j1.size() == j2.size());
+        auto it1 = j1.object_range().begin();
+        auto it2 = j2.object_range().begin();
+        for (; it1 != j1.object_range().end(); ++it1, ++it2)
+        {
+            CHECK(it1->key() == it2->key());
+            CHECK(it1->value().template as<int>() == it2->value().template as<int>());
+        }
+        for (const auto& member : j2.object_range())
+        {
+            auto it = j1.find(member.key());
+            REQUIRE(bool(it != j1.object_range().end()));
+            CHECK(it->key() == member.key());
+        }
+    }
+
+}
+
+TEST_CASE("hash_indexed_json_object parse tests")
+{
+    SECTION("insertion order is preserved")
+    {
+        std::string input = R"({"street_number":"100","street_name":"Queen St W","city":"Toronto","country":"Canada"})";
+        hjson j = hjson::parse(input);
+
+        auto it = j.object_range().begin();
+        CHECK(it++->key() == "street_number");
+        CHECK(it++->key() == "street_name");
+        CHECK(it++->key() == "city");
+        CHECK(it++->key() == "country");
+        CHECK(j.to_string() == input);
+    }
+
+    SECTION("duplicate names keep the first")
+    {
+        std::string input = R"({"a":1,"b":2,"a":3,"c":4,"d":5,"e":6,"f":7,"g":8,"h":9,"c":10,"i":11})";
+        hjson j = hjson::parse(input);
+        ojson oj = ojson::parse(input);
+
+        check_same_members(j, oj);
+        CHECK(j.at("a").as<int>() == 1);
+        CHECK(j.at("c").as<int>() == 4);
+    }
+
+    SECTION("large object")
+    {
+        std::string input = "{";
+        for (int i = 0; i < 5000; ++i)
+        {
+            if (i > 0)
+            {
+                input.push_back(',');
+            }
+            input += "\"key" + std::to_string(i) + "\":" + std::to_string(i);
+        }
+        input += "}";
+
+        hjson j = hjson::parse(input);
+        REQUIRE(j.size() == 5000);
+        for (int i = 0; i < 5000; ++i)
+        {
+            CHECK(j.at("key" + std::to_string(i)).as<int>() == i);
+        }
+        CHECK_FALSE(j.contains("key5000"));
+        CHECK(j.object_range().begin()->key() == "key0");
+    }
+}
+
+TEST_CASE("hash_indexed_json_object modifier tests")
+{
+    hjson j;
+    for (int i = 0; i < 20; ++i)
+    {
+        j.insert_or_assign("k" + std::to_string(i), i);
+    }
+
+    SECTION("insert_or_assign existing")
+    {
+        j.insert_or_assign("k3", 100);
+        CHECK(j.size() == 20);
+        CHECK(j.at("k3").as<int>() == 100);
+    }
+
+    SECTION("erase keeps the index consistent")
+    {
+        j.erase("k0");
+        j.erase("k10");
+        j.erase(j.object_range().begin() + 3, j.object_range().begin() + 6);
+        CHECK(j.size() == 15);
+        CHECK_FALSE(j.contains("k0"));
+        CHECK_FALSE(j.contains("k10"));
+        CHECK_FALSE(j.contains("k4"));
+        CHECK_FALSE(j.contains("k6"));
+        CHECK(j.at("k7").as<int>() == 7);
+        CHECK(j.at("k19").as<int>() == 19);
+        for (const auto& member : j.object_range())
+        {
+            CHECK(j.find(member.key())->value() == member.value());
+        }
+    }
+
+    SECTION("insert with hint")
+    {
+        auto it = j.try_emplace(j.object_range().begin() + 1, "first", -1);
+        CHECK(it->key() == "first");
+        CHECK((j.object_range().begin() + 1)->key() == "first");
+        for (int i = 0; i < 20; ++i)
+        {
+            CHECK(j.at("k" + std::to_string(i)).as<int>() == i);
+        }
+        CHECK(j.at("first").as<int>() == -1);
+    }
+
+    SECTION("copy and swap")
+    {
+        hjson copy(j);
+        hjson other;
+        other.insert_or_assign("x", 1);
+        copy.swap(other);
+        CHECK(other.at("k19").as<int>() == 19);
+        CHECK(copy.at("x").as<int>() == 1);
+        CHECK_FALSE(copy.contains("k19"));
+        CHECK(other == j);
+    }
+
+    SECTION("clear")
+    {
+        j.object_value().clear();
+        CHECK(j.empty());
+        j.insert_or_assign("a", 1);
+        CHECK(j.at("a").as<int>() == 1);
+    }
+}
+
+TEST_CASE("hash_indexed_json_object agrees with order_preserving_json_object")
+{
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> key_dist(0, 300);
+    std::uniform_int_distribution<int> op_dist(0, 9);
+
+    hjson j;
+    ojson oj;
+    for (int n = 0; n < 3000; ++n)
+    {
+        std::string key = "member" + std::to_string(key_dist(gen));
+        int op = op_dist(gen);
+        if (op < 5)
+        {
+            j.insert_or_assign(key, n);
+            oj.insert_or_assign(key, n);
+        }
+        else if (op < 7)
+        {
+            j.try_emplace(key, n);
+            oj.try_emplace(key, n);
+        }
+        else if (op < 9)
+        {
+            j.erase(key);
+            oj.erase(key);
+        }
+        else
+        {
+            std::size_t pos = j.size() / 2;
+            j.try_emplace(j.object_range().begin() + pos, key, n);
+            oj.try_emplace(oj.object_range().begin() + pos, key, n);
+        }
+    }
+    check_same_members(j, oj);
+}
@@ -674,3 +674,136 @@ TEMPLATE_TEST_CASE("json_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+TEST_CASE("json_cursor skip test")
+{
+    std::string input = R"({
+    "skipped" : {
+        "a" : "a long string with brackets ] } and an escaped quote \" and backslash \\",
+        "b" : [1, 2, [3, {"c" : "\\\\\""}]],
+        "d" : "\\",
+        "e" : {}
+    },
+    "kept" : [true, false],
+    "last" : "x"
+})";
+
+    SECTION("skip object member")
+    {
+        json_string_cursor cursor(input);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == "skipped");
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == "kept");
+        CHECK(cursor.context().line() == 8);
+        CHECK(cursor.context().column() == 11);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == "last");
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == "x");
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("skip root")
+    {
+        json_string_cursor cursor(input);
+        cursor.skip();
+        CHECK(cursor.done());
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring winput = L"[{\"a\" : \"]\\\"}\"}, 2]";
+        wjson_string_cursor cursor(winput);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        CHECK(cursor.current().get<int>() == 2);
+    }
+
+    SECTION("skip with small buffers")
+    {
+        for (std::size_t buffer_size = 1; buffer_size <= 70; ++buffer_size)
+        {
+            std::istringstream is(input);
+            json_stream_cursor cursor(stream_source<char>(is, buffer_size));
+            cursor.next();
+            cursor.next();
+            REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+            std::error_code ec;
+            cursor.skip(ec);
+            REQUIRE_FALSE(ec);
+            REQUIRE(cursor.current().event_type() == staj_event_type::key);
+            CHECK(cursor.current().get<std::string>() == "kept");
+            CHECK(cursor.context().line() == 8);
+        }
+    }
+
+    SECTION("skip matches next")
+    {
+        std::string long_input = "[";
+        for (int i = 0; i < 100; ++i)
+        {
+            long_input.append("{\"id\" : \"\\\\\\\"[{\",\r\n \"values\" : [1,[2,{}],\"]]\"]},\n");
+        }
+        long_input.append("\"end\"]");
+
+        json_string_cursor cursor1(long_input);
+        json_string_cursor cursor2(long_input);
+        cursor1.next();
+        cursor2.next();
+        while (cursor1.current().event_type() == staj_event_type::begin_object)
+        {
+            cursor1.skip();
+            int depth = 0;
+            do
+            {
+                if (cursor2.current().event_type() == staj_event_type::begin_object || cursor2.current().event_type() == staj_event_type::begin_array)
+                {
+                    ++depth;
+                }
+                else if (cursor2.current().event_type() == staj_event_type::end_object || cursor2.current().event_type() == staj_event_type::end_array)
+                {
+                    --depth;
+                }
+                cursor2.next();
+            }
+            while (depth > 0);
+            CHECK(cursor1.context().line() == cursor2.context().line());
+            CHECK(cursor1.context().column() == cursor2.context().column());
+        }
+        CHECK(cursor1.current().get<std::string>() == "end");
+    }
+
+    SECTION("unexpected eof")
+    {
+        std::string bad = R"({"a" : [1, 2)";
+        json_string_cursor cursor(bad);
+        cursor.next();
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+
+    SECTION("skip with filter")
+    {
+        json_string_cursor cursor(input);
+        auto filtered = cursor | [](const staj_event& event, const ser_context&) {return event.event_type() != staj_event_type::key;};
+        filtered.next();
+        REQUIRE(filtered.current().event_type() == staj_event_type::begin_object);
+        filtered.skip();
+        CHECK(filtered.current().event_type() == staj_event_type::begin_array);
+    }
+}
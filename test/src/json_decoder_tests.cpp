@@ -0,0 +1,179 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+using hjson = basic_json<char,hash_indexed_policy>;
+
+namespace {
+
+    // Replays the events of a value, giving lengths for containers at even depths only
+    template <class Json>
+    void replay(const Json& val, json_visitor& visitor, std::size_t depth = 0)
+    {
+        const bool hint = depth % 2 == 0;
+        if (val.is_object())
+        {
+            if (hint)
+            {
+                visitor.begin_object(val.size());
+            }
+            else
+            {
+                visitor.begin_object();
+            }
+            for (const auto& member : val.object_range())
+            {
+                visitor.key(member.key());
+                replay(member.value(), visitor, depth+1);
+            }
+            visitor.end_object();
+        }
+        else if (val.is_array())
+        {
+            if (hint)
+            {
+                visitor.begin_array(val.size());
+            }
+            else
+            {
+                visitor.begin_array();
+            }
+            for (const auto& item : val.array_range())
+            {
+                replay(item, visitor, depth+1);
+            }
+            visitor.end_array();
+        }
+        else
+        {
+            val.dump(visitor);
+        }
+    }
+
+    template <class Json>
+    void check_replay(const std::string& input)
+    {
+        Json expected = Json::parse(input);
+
+        json_decoder<Json> decoder;
+        replay(expected, decoder);
+        REQUIRE(decoder.is_valid());
+        Json result = decoder.get_result();
+        CHECK(result == expected);
+        CHECK(result.to_string() == expected.to_string());
+
+        json_decoder<Json> decoder2;
+        expected.dump(decoder2);
+        REQUIRE(decoder2.is_valid());
+        CHECK(decoder2.get_result() == expected);
+    }
+
+} // namespace
+
+TEST_CASE("json_decoder with and without length hints")
+{
+    std::string input = R"(
+    {
+        "a" : [1, [2, {"b" : [3, 4], "c" : {"d" : [[5], [6, 7]]}}], "A string that is too long for a short string"],
+        "e" : {"f" : {"g" : {"h" : [], "i" : {}}}},
+        "j" : [[[[[8]]]], {"k" : null, "l" : true, "m" : 1.5, "n" : -9}],
+        "o" : "p",
+        "q" : {"r" : 1, "s" : 2, "t" : 3, "u" : 4, "v" : 5, "w" : 6, "x" : 7, "y" : 8, "z" : 9}
+    }
+    )";
+
+    SECTION("json")
+    {
+        check_replay<json>(input);
+    }
+    SECTION("ojson")
+    {
+        check_replay<ojson>(input);
+    }
+    SECTION("hash_indexed_policy")
+    {
+        check_replay<hjson>(input);
+    }
+    SECTION("root array")
+    {
+        check_replay<json>(R"([{"a" : [1,{"b" : [2]}]}, [[3]], 4])");
+    }
+}
+
+TEST_CASE("json_decoder duplicate names with length hints")
+{
+    SECTION("json")
+    {
+        json_decoder<json> decoder;
+        decoder.begin_object(3);
+        decoder.key("b");
+        decoder.uint64_value(1);
+        decoder.key("a");
+        decoder.uint64_value(2);
+        decoder.key("b");
+        decoder.uint64_value(3);
+        decoder.end_object();
+
+        json j = decoder.get_result();
+        CHECK(j.size() == 2);
+        CHECK(j.at("b").as<int>() == 1);
+    }
+
+    SECTION("ojson")
+    {
+        json_decoder<ojson> decoder;
+        decoder.begin_object(3);
+        decoder.key("b");
+        decoder.uint64_value(1);
+        decoder.key("a");
+        decoder.uint64_value(2);
+        decoder.key("b");
+        decoder.uint64_value(3);
+        decoder.end_object();
+
+        ojson j = decoder.get_result();
+        CHECK(j.size() == 2);
+        CHECK(j.at("b").as<int>() == 1);
+        CHECK(j.object_range().begin()->key() == "b");
+    }
+
+    SECTION("hash_indexed_policy")
+    {
+        json_decoder<hjson> decoder;
+        decoder.begin_object(20);
+        for (int i = 0; i < 20; ++i)
+        {
+            decoder.key("k" + std::to_string(i % 10));
+            decoder.int64_value(i);
+        }
+        decoder.end_object();
+
+        hjson j = decoder.get_result();
+        CHECK(j.size() == 10);
+        for (int i = 0; i < 10; ++i)
+        {
+            CHECK(j.at("k" + std::to_string(i)).as<int>() == i);
+        }
+    }
+}
+
+TEST_CASE("json_decoder length hint larger than the container")
+{
+    json_decoder<json> decoder;
+    decoder.begin_array(std::size_t(1) << 40);
+    decoder.begin_object(std::size_t(1) << 40);
+    decoder.key("a");
+    decoder.uint64_value(1);
+    decoder.end_object();
+    decoder.end_array();
+
+    json j = decoder.get_result();
+    CHECK(j.size() == 1);
+    CHECK(j[0].at("a").as<int>() == 1);
+}
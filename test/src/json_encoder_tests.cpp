@@ -8,6 +8,7 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <random>
 
 using namespace jsoncons;
 
@@ -115,3 +116,109 @@ TEMPLATE_TEST_CASE("test_json_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.string2() == R"(["foo",42])");
 }
+
+namespace {
+
+    // Escapes one character at a time, as the encoders did before they appended 
+    // runs of characters that need no escaping in one step
+    std::string escape_reference(const std::string& s, bool escape_all_non_ascii, bool escape_solidus)
+    {
+        std::string result;
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            switch (c)
+            {
+                case '\\': result += "\\\\"; break;
+                case '"': result += "\\\""; break;
+                case '\b': result += "\\b"; break;
+                case '\f': result += "\\f"; break;
+                case '\n': result += "\\n"; break;
+                case '\r': result += "\\r"; break;
+                case '\t': result += "\\t"; break;
+                default:
+                    if (escape_solidus && c == '/')
+                    {
+                        result += "\\/";
+                    }
+                    else if (c < 0x20 || c == 0x7f || (escape_all_non_ascii && c >= 0x80))
+                    {
+                        uint32_t cp;
+                        auto r = unicode_traits::to_codepoint(s.data() + i, s.data() + s.size(), cp);
+                        REQUIRE(r.ec == unicode_traits::conv_errc());
+                        i = static_cast<std::size_t>(r.ptr - s.data()) - 1;
+                        std::vector<uint32_t> units;
+                        if (cp > 0xFFFF)
+                        {
+                            cp -= 0x10000;
+                            units.push_back((cp >> 10) + 0xD800);
+                            units.push_back((cp & 0x03FF) + 0xDC00);
+                        }
+                        else
+                        {
+                            units.push_back(cp);
+                        }
+                        for (auto u : units)
+                        {
+                            char buf[8];
+                            snprintf(buf, sizeof(buf), "\\u%04X", u);
+                            result += buf;
+                        }
+                    }
+                    else
+                    {
+                        result.push_back(s[i]);
+                    }
+                    break;
+            }
+        }
+        return result;
+    }
+
+}
+
+TEST_CASE("json_encoder escaped strings")
+{
+    const std::string pieces[] = {"a", "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", "\"", "\\", "/", "\n", "\x01", "\x1f", "\x7f", 
+                                  " ", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80"};
+    std::mt19937 gen(19);
+    std::uniform_int_distribution<std::size_t> piece_dist(0, 12);
+    std::uniform_int_distribution<int> len_dist(0, 120);
+
+    for (std::size_t n = 0; n < 500; ++n)
+    {
+        std::string s;
+        int len = len_dist(gen);
+        for (int i = 0; i < len; ++i)
+        {
+            // Mostly plain characters
+            std::size_t k = piece_dist(gen);
+            s += pieces[k % 3 == 0 ? k : (k % 2)];
+        }
+
+        for (int options_index = 0; options_index < 4; ++options_index)
+        {
+            bool escape_all_non_ascii = (options_index & 1) != 0;
+            bool escape_solidus = (options_index & 2) != 0;
+            auto options = json_options{}
+                .escape_all_non_ascii(escape_all_non_ascii)
+                .escape_solidus(escape_solidus);
+
+            std::string expected = "\"" + escape_reference(s, escape_all_non_ascii, escape_solidus) + "\"";
+
+            std::string compact;
+            compact_json_string_encoder encoder1(compact, options);
+            encoder1.string_value(s);
+            encoder1.flush();
+            CHECK(compact == expected);
+
+            std::string pretty;
+            json_string_encoder encoder2(pretty, options);
+            encoder2.string_value(s);
+            encoder2.flush();
+            CHECK(pretty == expected);
+
+            CHECK(json::parse(compact).as<std::string>() == s);
+        }
+    }
+}
@@ -0,0 +1,190 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t n)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            s.append("{\"id\":" + std::to_string(i) + ",\"name\":\"n" + std::to_string(i) + "\",\"values\":[1,2.5,true]}\n");
+        }
+        return s;
+    }
+
+}
+
+TEST_CASE("json_lines_reader tests")
+{
+    const std::size_t n = 1000;
+    std::string input = make_lines(n);
+
+    SECTION("ordered")
+    {
+        for (std::size_t threads : {0, 1, 2, 4})
+        {
+            std::vector<json> values;
+            std::vector<std::size_t> lines;
+            json_lines_reader reader(input);
+            reader.num_threads(threads).chunk_size(100);
+            std::size_t count = reader.read([&](json&& j, std::size_t line)
+            {
+                values.push_back(std::move(j));
+                lines.push_back(line);
+            });
+            REQUIRE(count == n);
+            REQUIRE(values.size() == n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                CHECK(values[i]["id"].as<std::size_t>() == i);
+                CHECK(lines[i] == i + 1);
+            }
+        }
+    }
+
+    SECTION("unordered")
+    {
+        std::vector<std::size_t> ids;
+        json_lines_reader reader(input);
+        reader.num_threads(4).chunk_size(64).preserve_order(false);
+        std::size_t count = reader.read([&](json&& j, std::size_t line)
+        {
+            CHECK(j["id"].as<std::size_t>() + 1 == line);
+            ids.push_back(j["id"].as<std::size_t>());
+        });
+        REQUIRE(count == n);
+        std::sort(ids.begin(), ids.end());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(ids[i] == i);
+        }
+    }
+
+    SECTION("stream")
+    {
+        std::istringstream is(input);
+        std::vector<std::size_t> ids;
+        json_lines_reader reader(is);
+        reader.num_threads(3).chunk_size(50);
+        std::size_t count = reader.read([&](json&& j, std::size_t)
+        {
+            ids.push_back(j["id"].as<std::size_t>());
+        });
+        REQUIRE(count == n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(ids[i] == i);
+        }
+    }
+}
+
+TEST_CASE("json_lines_reader blank lines and line endings")
+{
+    std::string input = "\n[1]\r\n  \n{\"a\":2}\n\n\"x\"";
+
+    std::vector<std::pair<std::size_t,json>> values;
+    json_lines_reader reader(input);
+    reader.num_threads(2).chunk_size(4);
+    std::size_t count = reader.read([&](json&& j, std::size_t line)
+    {
+        values.emplace_back(line, std::move(j));
+    });
+    REQUIRE(count == 3);
+    CHECK(values[0].first == 2);
+    CHECK(values[0].second == json::parse("[1]"));
+    CHECK(values[1].first == 4);
+    CHECK(values[1].second == json::parse("{\"a\":2}"));
+    CHECK(values[2].first == 6);
+    CHECK(values[2].second.as<std::string>() == "x");
+}
+
+TEST_CASE("json_lines_reader errors")
+{
+    std::string input = make_lines(500);
+    input.append("{\"id\":500,\"name\":}\n");
+    input.append(make_lines(500));
+
+    SECTION("error code")
+    {
+        for (std::size_t threads : {1, 4})
+        {
+            std::size_t last_line = 0;
+            std::error_code ec;
+            json_lines_reader reader(input);
+            reader.num_threads(threads).chunk_size(128);
+            std::size_t count = reader.read([&](json&&, std::size_t line)
+            {
+                last_line = line;
+            }, ec);
+            CHECK(ec == json_errc::expected_value);
+            CHECK(count == 500);
+            CHECK(last_line == 500);
+            CHECK(reader.line() == 501);
+            CHECK(reader.column() == 18);
+        }
+    }
+
+    SECTION("exception")
+    {
+        json_lines_reader reader(input);
+        reader.num_threads(2).chunk_size(256);
+        REQUIRE_THROWS_AS(reader.read([](json&&, std::size_t){}), ser_error);
+    }
+
+    SECTION("error handler sees position in the whole text")
+    {
+        std::size_t error_line = 0;
+        auto err_handler = [&](json_errc, const ser_context& context) -> bool
+        {
+            error_line = context.line();
+            return false;
+        };
+        std::error_code ec;
+        json_lines_reader reader(input, json_options(), err_handler);
+        reader.num_threads(1);
+        reader.read([](json&&, std::size_t){}, ec);
+        CHECK(ec);
+        CHECK(error_line == 501);
+    }
+
+    SECTION("callback exception stops the workers")
+    {
+        json_lines_reader reader(input);
+        reader.num_threads(4).chunk_size(64);
+        std::size_t count = 0;
+        REQUIRE_THROWS_AS(reader.read([&](json&&, std::size_t)
+        {
+            if (++count == 10)
+            {
+                JSONCONS_THROW(std::runtime_error("stop"));
+            }
+        }), std::runtime_error);
+        CHECK(count == 10);
+    }
+}
+
+TEST_CASE("wojson_lines_reader")
+{
+    std::wstring input = L"{\"b\":1,\"a\":2}\n{\"c\":3}\n";
+    std::vector<wojson> values;
+    wojson_lines_reader reader(input);
+    reader.num_threads(2);
+    reader.read([&](wojson&& j, std::size_t)
+    {
+        values.push_back(std::move(j));
+    });
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].object_range().begin()->key() == L"b");
+    CHECK(values[1][L"c"].as<int>() == 3);
+}
@@ -338,3 +338,99 @@ TEST_CASE("test_diagnostics_visitor", "")
         CHECK(os.str() == expected.str());
     }
 }
+
+namespace {
+
+    // Records whether each key and string value points into [first,last)
+    class string_location_visitor : public default_json_visitor
+    {
+        const char* first_;
+        const char* last_;
+    public:
+        std::vector<std::pair<std::string,bool>> strings;
+
+        string_location_visitor(const char* first, const char* last)
+            : first_(first), last_(last)
+        {
+        }
+    private:
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            strings.emplace_back(std::string(name), name.data() >= first_ && name.data() < last_);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& s, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            strings.emplace_back(std::string(s), s.data() >= first_ && s.data() < last_);
+            return true;
+        }
+    };
+
+}
+
+TEST_CASE("json_parser string views into the input")
+{
+    std::string input = R"({"first":"abc","second":"d\ne","third":"\u00e9"})";
+
+    SECTION("json_parser")
+    {
+        string_location_visitor visitor(input.data(), input.data() + input.size());
+        json_parser parser;
+        parser.update(input.data(), input.size());
+        parser.finish_parse(visitor);
+
+        REQUIRE(visitor.strings.size() == 6);
+        CHECK(visitor.strings[0] == std::make_pair(std::string("first"), true));
+        CHECK(visitor.strings[1] == std::make_pair(std::string("abc"), true));
+        CHECK(visitor.strings[2] == std::make_pair(std::string("second"), true));
+        CHECK(visitor.strings[3] == std::make_pair(std::string("d\ne"), false));
+        CHECK(visitor.strings[4] == std::make_pair(std::string("third"), true));
+        CHECK(visitor.strings[5] == std::make_pair(std::string("\xc3\xa9"), false));
+    }
+
+    SECTION("json_string_reader")
+    {
+        string_location_visitor visitor(input.data(), input.data() + input.size());
+        json_string_reader reader(input, visitor);
+        reader.read();
+
+        REQUIRE(visitor.strings.size() == 6);
+        CHECK(visitor.strings[0].second);
+        CHECK(visitor.strings[1].second);
+        CHECK_FALSE(visitor.strings[3].second);
+    }
+
+    SECTION("json_string_cursor")
+    {
+        json_string_cursor cursor(input);
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            const auto& event = cursor.current();
+            if (event.event_type() == staj_event_type::key)
+            {
+                auto sv = event.get<jsoncons::string_view>();
+                CHECK(sv.data() >= input.data());
+                CHECK(sv.data() < input.data() + input.size());
+                ++count;
+            }
+        }
+        CHECK(count == 3);
+    }
+
+    SECTION("string split across buffers")
+    {
+        std::string part1 = R"(["ab)";
+        std::string part2 = R"(cd"])";
+        string_location_visitor visitor(part2.data(), part2.data() + part2.size());
+        json_parser parser;
+        parser.update(part1.data(), part1.size());
+        parser.parse_some(visitor);
+        parser.update(part2.data(), part2.size());
+        parser.finish_parse(visitor);
+
+        REQUIRE(visitor.strings.size() == 1);
+        CHECK(visitor.strings[0] == std::make_pair(std::string("abcd"), false));
+    }
+}
@@ -31,3 +31,14 @@ TEST_CASE("json storage tests")
     CHECK(json_storage_kind::double_value == var9.storage_kind());
 }
 
+
+TEST_CASE("json storage size tests")
+{
+    // Every alternative fits in 16 bytes: a one byte storage kind and length, 
+    // a semantic_tag, and an 8 byte payload or pointer, or up to 13 chars inline
+    CHECK(sizeof(json) == 16);
+    CHECK(sizeof(ojson) == 16);
+
+    CHECK(json("Thirteen char").storage_kind() == json_storage_kind::short_string_value);
+    CHECK(json(0.5).storage_kind() == json_storage_kind::double_value);
+}
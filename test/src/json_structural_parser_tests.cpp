@@ -0,0 +1,356 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_structural_parser.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace jsoncons;
+
+namespace {
+
+    json read_with_structural_index(const std::string& input)
+    {
+        auto options = json_options{}.structural_index(true);
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    std::error_code structural_index_error(const std::string& input)
+    {
+        auto options = json_options{}.structural_index(true);
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        return ec;
+    }
+
+    std::string random_string(std::mt19937& gen, std::size_t max_length)
+    {
+        const char* pieces[] = {"a", "b", " ", "\\", "\"", "\n", "\t", "/", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "{", "]", ":", ","};
+        std::uniform_int_distribution<std::size_t> length_dist(0, max_length);
+        std::uniform_int_distribution<std::size_t> piece_dist(0, sizeof(pieces)/sizeof(pieces[0]) - 1);
+
+        std::string s;
+        std::size_t length = length_dist(gen);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            s.append(pieces[piece_dist(gen)]);
+        }
+        return s;
+    }
+
+    json random_json(std::mt19937& gen, int depth)
+    {
+        std::uniform_int_distribution<int> kind_dist(0, depth > 3 ? 5 : 7);
+        switch (kind_dist(gen))
+        {
+            case 0:
+                return json(random_string(gen, 80));
+            case 1:
+                return json(std::uniform_int_distribution<int64_t>(-100000, 100000)(gen));
+            case 2:
+                return json(std::uniform_real_distribution<double>(-1.0e10, 1.0e10)(gen));
+            case 3:
+                return json(std::uniform_int_distribution<int>(0, 1)(gen) == 1);
+            case 4:
+                return json::null();
+            case 5:
+                return json((std::numeric_limits<uint64_t>::max)());
+            case 6:
+            {
+                json a(json_array_arg);
+                int n = std::uniform_int_distribution<int>(0, 6)(gen);
+                for (int i = 0; i < n; ++i)
+                {
+                    a.push_back(random_json(gen, depth + 1));
+                }
+                return a;
+            }
+            default:
+            {
+                json o;
+                int n = std::uniform_int_distribution<int>(0, 6)(gen);
+                for (int i = 0; i < n; ++i)
+                {
+                    o.try_emplace(random_string(gen, 20), random_json(gen, depth + 1));
+                }
+                return o;
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE("json_structural_parser valid documents")
+{
+    std::vector<std::string> inputs = {
+        "{}",
+        "[]",
+        "  [ ]  ",
+        "\"\"",
+        "0",
+        "-0",
+        "12345",
+        "-9223372036854775808",
+        "18446744073709551615",
+        "1.5",
+        "-1.5e-10",
+        "2E+3",
+        "true",
+        "false",
+        "null",
+        "[1,2,3]",
+        "{\"a\":1,\"b\":[true,false,null],\"c\":{\"d\":\"e\"}}",
+        "\r\n{\r\n  \"a\" : [ 1 , 2.5 , \"x\" ] \t}\r\n",
+        "[\"\\\"\",\"\\\\\",\"\\/\",\"\\b\\f\\n\\r\\t\"]",
+        "[\"\\u00e9\\u20AC\\ud83d\\ude00\"]",
+        "[\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"]",
+        "[[[[[[[[[[]]]]]]]]]]",
+        "{\"a\":{\"b\":{\"c\":{\"d\":[1,{\"e\":[]}]}}}}"
+    };
+
+    for (const auto& input : inputs)
+    {
+        CHECK(read_with_structural_index(input) == json::parse(input));
+    }
+}
+
+TEST_CASE("json_structural_parser block boundaries")
+{
+    SECTION("strings and escapes straddling 64 byte blocks")
+    {
+        for (std::size_t pad = 0; pad < 140; ++pad)
+        {
+            std::string input = "[" + std::string(pad, ' ') + "\"ab\\\\\\\"cd\\\\\", \"\\\\\"," + std::string(pad % 7, '\n') + "123, \"x\"]";
+            REQUIRE(read_with_structural_index(input) == json::parse(input));
+        }
+    }
+    SECTION("runs of backslashes")
+    {
+        for (std::size_t pad = 0; pad < 70; ++pad)
+        {
+            for (std::size_t n = 1; n < 10; ++n)
+            {
+                std::string value(n*2, '\\');
+                std::string input = "{" + std::string(pad, ' ') + "\"k\":\"" + value + "\",\"m\":\"" + value + "\\\"\"}";
+                REQUIRE(read_with_structural_index(input) == json::parse(input));
+            }
+        }
+    }
+    SECTION("input larger than one index chunk")
+    {
+        for (std::size_t pad = 16370; pad < 16400; ++pad)
+        {
+            std::string input = "[\"" + std::string(pad, 'a') + "\\\\\\\"\", 12345, [true], \"" + std::string(pad, ',') + "\",null]";
+            REQUIRE(read_with_structural_index(input) == json::parse(input));
+        }
+    }
+    SECTION("scalars at the end of a block")
+    {
+        for (std::size_t pad = 0; pad < 70; ++pad)
+        {
+            std::string input = std::string(pad, ' ') + "-12.5e3";
+            REQUIRE(read_with_structural_index(input) == json::parse(input));
+        }
+    }
+}
+
+TEST_CASE("json_structural_parser agrees with json_parser")
+{
+    std::mt19937 gen(1234);
+    for (int i = 0; i < 200; ++i)
+    {
+        json expected = random_json(gen, 0);
+        std::string compact;
+        expected.dump(compact);
+        std::string pretty;
+        expected.dump(pretty, indenting::indent);
+
+        REQUIRE(read_with_structural_index(compact) == json::parse(compact));
+        REQUIRE(read_with_structural_index(pretty) == json::parse(pretty));
+    }
+}
+
+TEST_CASE("json_structural_parser errors")
+{
+    SECTION("error codes")
+    {
+        std::vector<std::pair<std::string,json_errc>> inputs = {
+            {"[1,2", json_errc::unexpected_eof},
+            {"{\"a\":1", json_errc::unexpected_eof},
+            {"\"abc", json_errc::unexpected_eof},
+            {"tru", json_errc::unexpected_eof},
+            {"[tru]", json_errc::invalid_value},
+            {"[nulll]", json_errc::invalid_value},
+            {"[1,]", json_errc::extra_comma},
+            {"{\"a\":1,}", json_errc::extra_comma},
+            {"[1 2]", json_errc::expected_comma_or_rbracket},
+            {"{\"a\":1 \"b\":2}", json_errc::expected_comma_or_rbrace},
+            {"{\"a\" 1}", json_errc::expected_colon},
+            {"{1:1}", json_errc::expected_key},
+            {"[01]", json_errc::leading_zero},
+            {"[1.]", json_errc::invalid_number},
+            {"[1e]", json_errc::invalid_number},
+            {"[-]", json_errc::invalid_number},
+            {"[1x]", json_errc::invalid_number},
+            {"['a']", json_errc::single_quote},
+            {"[\"a\\x\"]", json_errc::illegal_escaped_character},
+            {"[\"\\u12G4\"]", json_errc::invalid_unicode_escape_sequence},
+            {"[\"\\ud83d\"]", json_errc::expected_codepoint_surrogate_pair},
+            {"[\"a\tb\"]", json_errc::illegal_character_in_string},
+            {"[\"a\x01\"]", json_errc::illegal_control_character},
+            {"[\"\xc3" "a\"]", json_errc::expected_continuation_byte},
+            {"[\"\xc3\"]", json_errc::illegal_codepoint},
+            {"[1]]", json_errc::extra_character},
+            {"[1] x", json_errc::extra_character},
+            {"[1}", json_errc::expected_comma_or_rbracket},
+            {"{\"a\":1]", json_errc::expected_comma_or_rbrace},
+            {"]", json_errc::unexpected_rbracket},
+            {"}", json_errc::unexpected_rbrace},
+            {"[/*comment*/1]", json_errc::illegal_comment}
+        };
+
+        for (const auto& item : inputs)
+        {
+            std::error_code ec = structural_index_error(item.first);
+            CHECK(ec == item.second);
+        }
+    }
+
+    SECTION("max nesting depth")
+    {
+        auto options = json_options{}.structural_index(true).max_nesting_depth(3);
+        std::string input = "[[[[1]]]]";
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::max_nesting_depth_exceeded);
+    }
+
+    SECTION("line and column")
+    {
+        std::string input = "{\n  \"a\" : 1,\r\n  \"b\" : [1 2]\n}";
+        auto options = json_options{}.structural_index(true);
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::expected_comma_or_rbracket);
+        CHECK(reader.line() == 3);
+        CHECK(reader.column() == 12);
+    }
+}
+
+TEST_CASE("json_structural_parser options")
+{
+    SECTION("lossless_number")
+    {
+        std::string input = "[1.5,123456789012345678901234567890]";
+        auto options = json_options{}.structural_index(true).lossless_number(true);
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        CHECK(j[0].tag() == semantic_tag::bigdec);
+        CHECK(j[0].as_string() == "1.5");
+        CHECK(j[1].tag() == semantic_tag::bigint);
+        CHECK(j[1].as_string() == "123456789012345678901234567890");
+    }
+    SECTION("nan_to_str")
+    {
+        std::string input = "[\"NaN\",\"Inf\"]";
+        auto options = json_options{}.structural_index(true).nan_to_str("NaN").inf_to_str("Inf");
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        CHECK(j[0].as<double>() != j[0].as<double>());
+        CHECK(j[1].as<double>() == std::numeric_limits<double>::infinity());
+    }
+    SECTION("ignored for stream input")
+    {
+        std::istringstream is("[1,/*comment*/2]");
+        auto options = json_options{}.structural_index(true);
+        json_decoder<json> decoder;
+        json_stream_reader reader(is, decoder, options);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse("[1,2]"));
+    }
+}
+
+TEST_CASE("json_structural_parser multiple documents")
+{
+    std::string input = "{\"a\":1}\n[1,2]\n\"s\"\n3 \n";
+    auto options = json_options{}.structural_index(true);
+    json_decoder<json> decoder;
+    json_string_reader reader(input, decoder, options);
+
+    std::vector<json> results;
+    while (!reader.eof())
+    {
+        reader.read_next();
+        if (!reader.eof() || decoder.is_valid())
+        {
+            results.push_back(decoder.get_result());
+        }
+    }
+    REQUIRE(results.size() == 4);
+    CHECK(results[0] == json::parse("{\"a\":1}"));
+    CHECK(results[1] == json::parse("[1,2]"));
+    CHECK(results[2] == json("s"));
+    CHECK(results[3] == json(3));
+}
+
+TEST_CASE("json_structural_parser direct use")
+{
+    SECTION("pause and restart")
+    {
+        std::string input = "[1,[2,3],{\"a\":4}]";
+
+        class stop_after_two : public default_json_visitor
+        {
+        public:
+            std::size_t count = 0;
+        private:
+            bool visit_uint64(uint64_t, semantic_tag, const ser_context&, std::error_code&) override
+            {
+                return ++count % 2 != 0;
+            }
+        };
+
+        stop_after_two visitor;
+        json_structural_parser parser;
+        parser.update(input);
+        std::size_t pauses = 0;
+        parser.parse_some(visitor);
+        while (!parser.done())
+        {
+            ++pauses;
+            parser.restart();
+            parser.parse_some(visitor);
+        }
+        CHECK(visitor.count == 4);
+        CHECK(pauses == 2);
+        CHECK(parser.done());
+    }
+    SECTION("wide characters")
+    {
+        std::wstring input = L"{\"a\":[1,2.5,\"\\u00e9x\"]}";
+        json_decoder<wjson> decoder;
+        wjson_structural_parser parser;
+        parser.update(input);
+        parser.finish_parse(decoder);
+        parser.check_done();
+        wjson j = decoder.get_result();
+        CHECK(j == wjson::parse(input));
+    }
+}
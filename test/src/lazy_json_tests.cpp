@@ -0,0 +1,204 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/lazy_json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("lazy_json_document tests")
+{
+    std::string input = R"(
+    {
+        "name" : "Jane",
+        "age" : 42,
+        "active" : true,
+        "spouse" : null,
+        "tags" : ["a", "b\n", [], {}],
+        "address" : {"street" : "1 Main St", "zip" : "12345"},
+        "n\u0061me" : "escaped",
+        "scores" : [1.5, -2, 3e2]
+    }
+    )";
+
+    auto doc = lazy_json_document::parse(input);
+    lazy_json root = doc.root();
+
+    SECTION("types")
+    {
+        CHECK(root.is_object());
+        CHECK(root.at("name").is_string());
+        CHECK(root.at("age").is_number());
+        CHECK(root.at("active").is_bool());
+        CHECK(root.at("spouse").is_null());
+        CHECK(root.at("tags").is_array());
+        CHECK(root.at("address").is_object());
+    }
+
+    SECTION("at and as")
+    {
+        CHECK(root.at("name").as<std::string>() == "Jane");
+        CHECK(root.at("age").as<int>() == 42);
+        CHECK(root.at("active").as<bool>());
+        CHECK(root.at("address").at("zip").as<std::string>() == "12345");
+        CHECK(root.at("tags").at(1).as<std::string>() == "b\n");
+        CHECK(root.at("scores").at(2).as<double>() == 300.0);
+        CHECK(root.at("tags").at(2).empty());
+        CHECK(root.at("tags").at(3).empty());
+        CHECK_FALSE(root.at("tags").empty());
+    }
+
+    SECTION("text")
+    {
+        CHECK(root.at("age").text() == "42");
+        CHECK(root.at("name").text() == "\"Jane\"");
+        CHECK(root.at("address").text() == R"({"street" : "1 Main St", "zip" : "12345"})");
+    }
+
+    SECTION("find and contains")
+    {
+        CHECK(root.contains("spouse"));
+        CHECK_FALSE(root.contains("children"));
+        CHECK_FALSE(root.at("age").contains("x"));
+        auto it = root.find("address");
+        REQUIRE(it != root.object_range().end());
+        CHECK(it->key() == "address");
+        CHECK(it->value().at("street").as<std::string>() == "1 Main St");
+    }
+
+    SECTION("size")
+    {
+        CHECK(root.size() == 8);
+        CHECK(root.at("tags").size() == 4);
+        CHECK(root.at("age").size() == 0);
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.emplace_back(member.key());
+        }
+        std::vector<std::string> expected_keys = {"name","age","active","spouse","tags","address","name","scores"};
+        CHECK(keys == expected_keys);
+
+        std::vector<double> scores;
+        for (const auto& item : root.at("scores").array_range())
+        {
+            scores.push_back(item.as<double>());
+        }
+        CHECK(scores == std::vector<double>{1.5, -2, 300.0});
+    }
+
+    SECTION("escaped key")
+    {
+        // The first of the duplicate names is found
+        CHECK(root.at("name").as<std::string>() == "Jane");
+        auto range = root.object_range();
+        auto it = range.begin();
+        for (int i = 0; i < 6; ++i)
+        {
+            ++it;
+        }
+        auto copy = it;
+        ++it;
+        CHECK(copy->key() == "name");
+        CHECK(copy->value().as<std::string>() == "escaped");
+    }
+
+    SECTION("materialize")
+    {
+        CHECK(root.materialize() == json::parse(input));
+        CHECK(root.at("tags").materialize() == json::parse(R"(["a", "b\n", [], {}])"));
+    }
+
+    SECTION("exceptions")
+    {
+        CHECK_THROWS_AS(root.at("children"), key_not_found);
+        CHECK_THROWS_AS(root.at("tags").at(4), std::out_of_range);
+        CHECK_THROWS_AS(root.at(0), std::domain_error);
+        CHECK_THROWS_AS(root.at("age").at("x"), not_an_object);
+        CHECK_THROWS_AS(root.at("age").array_range(), std::domain_error);
+    }
+}
+
+TEST_CASE("lazy_json_document scalars")
+{
+    std::string input = " 12345 ";
+    auto doc = lazy_json_document::parse(input);
+    CHECK(doc.root().is_number());
+    CHECK(doc.root().text() == "12345");
+    CHECK(doc.root().as<int>() == 12345);
+}
+
+TEST_CASE("lazy_json_document errors")
+{
+    SECTION("structure")
+    {
+        std::vector<std::pair<std::string,json_errc>> cases = {
+            {"", json_errc::unexpected_eof},
+            {"{\"a\":1", json_errc::unexpected_eof},
+            {"[\"abc", json_errc::unexpected_eof},
+            {"[1,2}", json_errc::expected_comma_or_rbracket},
+            {"{\"a\":1]", json_errc::expected_comma_or_rbrace},
+            {"{\"a\" 1}", json_errc::expected_colon},
+            {"{\"a\":1,}", json_errc::extra_comma},
+            {"{1:1}", json_errc::expected_key},
+            {"[1 2]", json_errc::expected_comma_or_rbracket},
+            {"[,]", json_errc::expected_value},
+            {"[] []", json_errc::extra_character}
+        };
+        for (const auto& item : cases)
+        {
+            std::error_code ec;
+            lazy_json_document::parse(item.first, ec);
+            CHECK(ec == item.second);
+        }
+    }
+
+    SECTION("parse throws")
+    {
+        std::string input = "{\n\"a\" : 1,\n\"b\" 2}";
+        try
+        {
+            lazy_json_document::parse(input);
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::expected_colon);
+            CHECK(e.line() == 3);
+            CHECK(e.column() == 5);
+        }
+    }
+
+    SECTION("values are checked when materialized")
+    {
+        std::string input = "{\n\"a\" : 1,\n\"b\" : trux}";
+        auto doc = lazy_json_document::parse(input);
+        CHECK(doc.root().at("a").as<int>() == 1);
+        try
+        {
+            doc.root().at("b").materialize();
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::invalid_value);
+            CHECK(e.line() == 3);
+        }
+    }
+}
+
+TEST_CASE("wlazy_ojson_document")
+{
+    std::wstring input = L"{\"b\":1,\"a\":[true,\"x\"]}";
+    auto doc = wlazy_ojson_document::parse(input);
+    wlazy_ojson root = doc.root();
+    CHECK(root.at(L"a").at(1).as<std::wstring>() == L"x");
+    CHECK(root.materialize().object_range().begin()->key() == L"b");
+}
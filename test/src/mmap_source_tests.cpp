@@ -0,0 +1,109 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <cstdio>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("mmap_source tests")
+{
+    std::string path = "./input/address-book.json";
+    std::ifstream is(path);
+    json expected = json::parse(is);
+
+    SECTION("basic_json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source> reader(mmap_source(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("basic_json_reader with structural index")
+    {
+        json_decoder<json> decoder;
+        auto options = json_options{}.structural_index(true);
+        basic_json_reader<char,mmap_source> reader(mmap_source(path), decoder, options);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("basic_json_cursor")
+    {
+        basic_json_cursor<char,mmap_source> cursor{mmap_source(path)};
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::key)
+            {
+                ++count;
+            }
+        }
+        CHECK(count == 5);
+    }
+
+    SECTION("position and read")
+    {
+        mmap_source source(path);
+        REQUIRE_FALSE(source.is_error());
+        char buffer[4];
+        source.ignore(4);
+        CHECK(source.position() == 4);
+        CHECK(source.read(buffer, 4) == 4);
+        CHECK(source.position() == 8);
+        auto span = source.read_buffer();
+        CHECK(source.eof());
+        CHECK(span.size() + 8 == static_cast<std::size_t>(std::ifstream(path, std::ios::binary | std::ios::ate).tellg()));
+    }
+
+    SECTION("moved from")
+    {
+        mmap_source source(path);
+        mmap_source other(std::move(source));
+        CHECK(source.eof());
+        CHECK_FALSE(other.eof());
+        CHECK(other.position() == 0);
+        CHECK(other.read_buffer().size() > 0);
+    }
+}
+
+TEST_CASE("mmap_source errors")
+{
+    SECTION("missing file")
+    {
+        mmap_source source("./input/no-such-file.json");
+        CHECK(source.is_error());
+        CHECK(source.error());
+        CHECK(source.eof());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source> reader(std::move(source), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+
+    SECTION("empty file")
+    {
+        std::string path = "./output/mmap_source_empty.json";
+        {
+            std::ofstream os(path);
+        }
+        mmap_source source(path);
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source> reader(std::move(source), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        // Same as an empty string_source
+        CHECK_FALSE(ec);
+        std::remove(path.c_str());
+    }
+}
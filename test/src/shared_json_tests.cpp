@@ -0,0 +1,121 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/shared_json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("shared_json tests")
+{
+    json j = json::parse(R"(
+    {
+        "config" : {"name" : "A name that is too long for a short string", "retries" : 3},
+        "items" : [{"id" : 1}, {"id" : 2}, {"id" : 3}],
+        "big" : [1,2,3,4,5,6,7,8,9,10]
+    }
+    )");
+
+    shared_json doc(j);
+
+    SECTION("read access")
+    {
+        CHECK(doc.root().at("config").at("retries").as<int>() == 3);
+        CHECK(doc.root().at("items").size() == 3);
+        CHECK(doc.root().at("items")[1].at("id").as<int>() == 2);
+        CHECK(doc.root() == j);
+        CHECK(doc.to_json() == j);
+        CHECK(doc.root().to_string() == j.to_string());
+    }
+
+    SECTION("copies share until modified")
+    {
+        shared_json copy(doc);
+        CHECK(copy.shares_root_with(doc));
+
+        copy.set("/config/retries", json(5));
+        CHECK_FALSE(copy.shares_root_with(doc));
+        CHECK(copy.root().at("config").at("retries").as<int>() == 5);
+        CHECK(doc.root().at("config").at("retries").as<int>() == 3);
+
+        // Untouched subtrees are the same storage
+        CHECK(&copy.root().at("big").at(0) == &doc.root().at("big").at(0));
+        CHECK(&copy.root().at("items").at(2) == &doc.root().at("items").at(2));
+        CHECK(copy.root().at("config").at("name").as_string_view().data() == 
+              doc.root().at("config").at("name").as_string_view().data());
+        CHECK(doc.root() == j);
+    }
+
+    SECTION("add and replace")
+    {
+        shared_json copy(doc);
+        copy.set("/config/timeout", json(30));
+        copy.set("/items/-", json::parse(R"({"id" : 4})"));
+        copy.set("/items/0", json::parse(R"({"id" : 0})"));
+        copy.set("/a~1b", json("slash"));
+
+        CHECK(copy.root().at("config").at("timeout").as<int>() == 30);
+        CHECK(copy.root().at("items").size() == 4);
+        CHECK(copy.root().at("items")[0].at("id").as<int>() == 0);
+        CHECK(copy.root().at("items")[3].at("id").as<int>() == 4);
+        CHECK(copy.root().at("a/b").as<std::string>() == "slash");
+        CHECK(doc.root() == j);
+
+        json expected = j;
+        expected["config"]["timeout"] = 30;
+        expected["items"].push_back(json::parse(R"({"id" : 4})"));
+        expected["items"][0] = json::parse(R"({"id" : 0})");
+        expected["a/b"] = "slash";
+        CHECK(copy.to_json() == expected);
+    }
+
+    SECTION("erase")
+    {
+        shared_json copy(doc);
+        copy.erase("/items/1");
+        copy.erase("/config/name");
+
+        CHECK(copy.root().at("items").size() == 2);
+        CHECK(copy.root().at("items")[1].at("id").as<int>() == 3);
+        CHECK_FALSE(copy.root().at("config").contains("name"));
+        CHECK(doc.root() == j);
+    }
+
+    SECTION("replace root")
+    {
+        shared_json copy(doc);
+        copy.set("", json(json_array_arg));
+        CHECK(copy.root().is_array());
+        CHECK(doc.root().is_object());
+    }
+
+    SECTION("errors")
+    {
+        shared_json copy(doc);
+        CHECK_THROWS(copy.set("/missing/x", json(1)));
+        CHECK_THROWS(copy.set("/big/11", json(1)));
+        CHECK_THROWS(copy.set("/big/01", json(1)));
+        CHECK_THROWS(copy.set("config", json(1)));
+        CHECK_THROWS(copy.erase("/missing"));
+        CHECK_THROWS(copy.erase("/big/-"));
+        CHECK_THROWS(copy.set("/config/retries/x", json(1)));
+        CHECK(copy.shares_root_with(doc));
+    }
+}
+
+TEST_CASE("shared_ojson preserves order")
+{
+    ojson j = ojson::parse(R"({"c" : 1, "a" : 2, "b" : 3})");
+    shared_ojson doc(j);
+    doc.set("/a", ojson(20));
+    doc.set("/d", ojson(4));
+
+    auto it = doc.root().object_range().begin();
+    CHECK(it++->key() == "c");
+    CHECK(it->key() == "a");
+    CHECK(it++->value().as<int>() == 20);
+    CHECK(it++->key() == "b");
+    CHECK(it++->key() == "d");
+}
@@ -9,6 +9,9 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cstring>
+#include <cmath>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -53,3 +56,97 @@ TEST_CASE("test_exponent")
 
 }
 
+
+TEST_CASE("detail::to_double tests")
+{
+    auto to_double = [](const std::string& s) -> double
+    {
+        double val = 0;
+        auto result = jsoncons::detail::to_double(s.data(), s.length(), val);
+        CHECK(result.ptr == s.data() + s.length());
+        return val;
+    };
+
+    SECTION("halfway cases round to even")
+    {
+        CHECK(to_double("9007199254740993") == 9007199254740992.0);
+        CHECK(to_double("9007199254740995") == 9007199254740996.0);
+        CHECK(to_double("9007199254740993.0000000000000000000000000000001") == 9007199254740994.0);
+        CHECK(to_double("4503599627370496.5") == 4503599627370496.0);
+        CHECK(to_double("4503599627370497.5") == 4503599627370498.0);
+    }
+    SECTION("long digit strings")
+    {
+        CHECK(to_double("1.00000000000000011102230246251565404236316680908203125") == 1.0);
+        CHECK(to_double("1.00000000000000011102230246251565404236316680908203126") == 1.0000000000000002);
+        CHECK(to_double("3.141592653589793238462643383279502884197169399375105820974944") == 3.141592653589793);
+        CHECK(to_double("100000000000000000000000000000000000000000000000000000000000") == 1e59);
+    }
+    SECTION("subnormals")
+    {
+        CHECK(to_double("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+        CHECK(to_double("2.4703282292062327e-324") == 0.0);
+        CHECK(to_double("2.4703282292062328e-324") == std::numeric_limits<double>::denorm_min());
+        CHECK(to_double("2.2250738585072011e-308") == 2.225073858507201e-308);
+        CHECK(to_double("2.2250738585072014e-308") == (std::numeric_limits<double>::min)());
+    }
+    SECTION("out of range")
+    {
+        CHECK(to_double("1.7976931348623157e308") == (std::numeric_limits<double>::max)());
+        CHECK(to_double("1.7976931348623159e308") == std::numeric_limits<double>::infinity());
+        CHECK(to_double("-1e400") == -std::numeric_limits<double>::infinity());
+        CHECK(to_double("1e-400") == 0.0);
+        CHECK(to_double("5001173100E95978") == std::numeric_limits<double>::infinity());
+    }
+    SECTION("hexadecimal")
+    {
+        CHECK(to_double("0x3p-1") == 1.5);
+        CHECK(to_double("0X1.8P+1") == 3.0);
+        CHECK(to_double("0x1p-1074") == std::numeric_limits<double>::denorm_min());
+        CHECK(to_double("0x1.fffffffffffffp1023") == (std::numeric_limits<double>::max)());
+    }
+    SECTION("partial and invalid input")
+    {
+        double val = 0;
+        std::string s = "1.5e+x";
+        auto result = jsoncons::detail::to_double(s.data(), s.length(), val);
+        CHECK(result);
+        CHECK(result.ptr == s.data() + 3);
+        CHECK(val == 1.5);
+
+        s = "abc";
+        result = jsoncons::detail::to_double(s.data(), s.length(), val);
+        CHECK_FALSE(result);
+        CHECK(result.ec == std::errc::invalid_argument);
+    }
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-2.5e-3";
+        double val = 0;
+        auto result = jsoncons::detail::to_double(s.data(), s.length(), val);
+        CHECK(result);
+        CHECK(val == -0.0025);
+    }
+}
+
+TEST_CASE("detail::to_double agrees with strtod")
+{
+    std::mt19937_64 gen(7);
+    char buffer[64];
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        uint64_t bits = gen();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (std::isnan(d))
+        {
+            continue;
+        }
+        snprintf(buffer, sizeof(buffer), i % 2 == 0 ? "%.17g" : "%.25e", d);
+        char* end = nullptr;
+        double expected = strtod(buffer, &end);
+        double val = 0;
+        jsoncons::detail::to_double(buffer, end - buffer, val);
+        REQUIRE(val == expected);
+    }
+}
@@ -0,0 +1,181 @@
+// Copyright 2021 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/tape_json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <limits>
+
+using namespace jsoncons;
+
+TEST_CASE("tape_json_document tests")
+{
+    std::string input = R"(
+    {
+        "name" : "Jane",
+        "age" : 42,
+        "big" : 18446744073709551615,
+        "neg" : -7,
+        "ratio" : 0.25,
+        "active" : true,
+        "spouse" : null,
+        "tags" : ["a", "b\n", [], {}],
+        "address" : {"street" : "1 Main St", "zip" : "12345"}
+    }
+    )";
+
+    auto doc = tape_json_document::parse(input);
+    tape_json root = doc.root();
+
+    SECTION("types")
+    {
+        CHECK(root.type() == json_type::object_value);
+        CHECK(root.at("name").is_string());
+        CHECK(root.at("age").is_int64());
+        CHECK(root.at("age").is_uint64());
+        CHECK(root.at("neg").is_int64());
+        CHECK_FALSE(root.at("neg").is_uint64());
+        CHECK_FALSE(root.at("big").is_int64());
+        CHECK(root.at("big").is_uint64());
+        CHECK(root.at("ratio").is_double());
+        CHECK(root.at("active").is_bool());
+        CHECK(root.at("spouse").is_null());
+        CHECK(root.at("tags").is_array());
+        CHECK(root.at("address").is_object());
+        CHECK(root.at("age").is_number());
+    }
+
+    SECTION("as")
+    {
+        CHECK(root.at("name").as<std::string>() == "Jane");
+        CHECK(root.at("name").as<jsoncons::string_view>() == "Jane");
+        CHECK(root.at("age").as<int>() == 42);
+        CHECK(root.at("big").as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(root.at("neg").as<int64_t>() == -7);
+        CHECK(root.at("ratio").as<double>() == 0.25);
+        CHECK(root.at("active").as<bool>());
+        CHECK(root.at("age").as<std::string>() == "42");
+        CHECK(root["address"]["zip"].as<std::string>() == "12345");
+        CHECK(root["tags"][1].as<std::string>() == "b\n");
+        CHECK(root.at("tags").as<std::vector<json>>().size() == 4);
+        CHECK(root.at("neg").as<uint32_t>() == json(-7).as<uint32_t>());
+    }
+
+    SECTION("size and empty")
+    {
+        CHECK(root.size() == 9);
+        CHECK(root.at("tags").size() == 4);
+        CHECK(root.at("tags").at(2).empty());
+        CHECK(root.at("tags").at(3).empty());
+        CHECK_FALSE(root.at("tags").empty());
+        CHECK(root.at("age").size() == 0);
+    }
+
+    SECTION("find and contains")
+    {
+        CHECK(root.contains("spouse"));
+        CHECK_FALSE(root.contains("children"));
+        CHECK_FALSE(root.at("age").contains("x"));
+        auto it = root.find("address");
+        REQUIRE(it != root.object_range().end());
+        CHECK(it->key() == "address");
+        CHECK(it->value().at("street").as<std::string>() == "1 Main St");
+        CHECK(root.find("children") == root.object_range().end());
+    }
+
+    SECTION("iteration")
+    {
+        json expected = json::parse(input);
+
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.emplace_back(member.key());
+            CHECK(member.value().materialize() == expected.at(member.key()));
+        }
+        CHECK(keys.size() == 9);
+        CHECK(keys.front() == "name");
+        CHECK(keys.back() == "address");
+
+        std::size_t count = 0;
+        for (const auto& item : root.at("tags").array_range())
+        {
+            CHECK(item.materialize() == expected["tags"][count]);
+            ++count;
+        }
+        CHECK(count == 4);
+    }
+
+    SECTION("materialize and dump")
+    {
+        CHECK(root.materialize() == json::parse(input));
+        CHECK(root.at("address").materialize() == json::parse(R"({"street" : "1 Main St", "zip" : "12345"})"));
+
+        std::string s;
+        compact_json_string_encoder encoder(s);
+        root.at("tags").dump(encoder);
+        CHECK(s == R"(["a","b\n",[],{}])");
+    }
+
+    SECTION("exceptions")
+    {
+        CHECK_THROWS_AS(root.at("children"), key_not_found);
+        CHECK_THROWS_AS(root.at("tags").at(4), std::out_of_range);
+        CHECK_THROWS_AS(root.at(0), std::domain_error);
+        CHECK_THROWS_AS(root.at("age").at("x"), not_an_object);
+        CHECK_THROWS_AS(root.at("age").array_range(), std::domain_error);
+        CHECK_THROWS_AS(root.at("age").as_string_view(), std::domain_error);
+    }
+}
+
+TEST_CASE("tape_json_document scalars")
+{
+    CHECK(tape_json_document::parse("123").root().as<int>() == 123);
+    CHECK(tape_json_document::parse("\"abc\"").root().as<std::string>() == "abc");
+    CHECK(tape_json_document::parse("null").root().is_null());
+    CHECK(tape_json_document().root().is_null());
+    // begin_array and size, int64 and bits, string and length, end_array
+    CHECK(tape_json_document::parse("[-1,\"ab\"]").tape_size() == 7);
+    CHECK_THROWS_AS(tape_json_document::parse("[1,2"), ser_error);
+    CHECK_THROWS_AS(tape_json_document::parse("[1] 2"), ser_error);
+}
+
+TEST_CASE("tape_json_decoder with cbor")
+{
+    json j;
+    j["bytes"] = json(byte_string_arg, std::vector<uint8_t>{1,2,3});
+    j["half"] = json(half_arg, 0x3c00);
+    j["date"] = json("2021-01-01T00:00:00Z", semantic_tag::datetime);
+    j["array"] = json::parse("[1,[2,[3]],{\"a\":null}]");
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+
+    tape_json_decoder<json> decoder;
+    cbor::cbor_bytes_reader reader(data, decoder);
+    reader.read();
+    REQUIRE(decoder.is_valid());
+    tape_json_document doc = decoder.get_result();
+
+    tape_json root = doc.root();
+    CHECK(root.at("bytes").is_byte_string());
+    CHECK(root.at("bytes").as_byte_string_view().size() == 3);
+    json expected = cbor::decode_cbor<json>(data);
+    CHECK(root.at("half").type() == expected["half"].type());
+    CHECK(root.at("half").as<double>() == 1.0);
+    CHECK(root.at("date").tag() == semantic_tag::datetime);
+    CHECK(root.materialize() == expected);
+}
+
+TEST_CASE("wtape_ojson_document")
+{
+    std::wstring input = L"{\"b\":1,\"a\":[true,\"x\"]}";
+    auto doc = wtape_ojson_document::parse(input);
+    wtape_ojson root = doc.root();
+    CHECK(root.at(L"a").at(1).as<std::wstring>() == L"x");
+    CHECK(root.object_range().begin()->key() == L"b");
+    CHECK(root.materialize().object_range().begin()->key() == L"b");
+}
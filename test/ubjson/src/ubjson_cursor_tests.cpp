@@ -414,3 +414,114 @@ TEMPLATE_TEST_CASE("ubjson_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+namespace {
+
+    // Returns the events that follow each member of the root object, skipping 
+    // nested containers with skip() or by stepping through their events with next()
+    template <class Cursor>
+    std::vector<std::string> events_after_skip(Cursor& cursor, bool use_skip)
+    {
+        std::vector<std::string> events;
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        while (!cursor.done())
+        {
+            const auto& event = cursor.current();
+            std::ostringstream os;
+            os << event.event_type();
+            if (event.event_type() == staj_event_type::key || event.event_type() == staj_event_type::string_value)
+            {
+                os << " " << event.template get<std::string>();
+            }
+            events.push_back(os.str());
+            if (event.event_type() == staj_event_type::begin_object || event.event_type() == staj_event_type::begin_array)
+            {
+                if (use_skip)
+                {
+                    cursor.skip();
+                }
+                else
+                {
+                    int depth = 0;
+                    do
+                    {
+                        auto type = cursor.current().event_type();
+                        if (type == staj_event_type::begin_object || type == staj_event_type::begin_array)
+                        {
+                            ++depth;
+                        }
+                        else if (type == staj_event_type::end_object || type == staj_event_type::end_array)
+                        {
+                            --depth;
+                        }
+                        cursor.next();
+                    }
+                    while (depth > 0);
+                }
+            }
+            else
+            {
+                cursor.next();
+            }
+        }
+        return events;
+    }
+
+} // namespace
+
+TEST_CASE("ubjson_cursor skip test")
+{
+    SECTION("encoded")
+    {
+        ojson j = ojson::parse(R"(
+        {
+            "a" : [1, [2, "three"], {"x" : 1.5, "y" : -1000000, "z" : 4294967296}],
+            "b" : {"c" : {"d" : [true, null, false]}, "e" : "a text string"},
+            "f" : -7,
+            "h" : [],
+            "i" : {},
+            "j" : "a text string",
+            "k" : "18446744073709551616"
+        }
+        )");
+        j["k"] = ojson("18446744073709551616", semantic_tag::bigint);
+
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(j, data);
+
+        ubjson::ubjson_bytes_cursor cursor1(data);
+        ubjson::ubjson_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 15);
+    }
+
+    SECTION("typed and indefinite containers")
+    {
+        // {"a":[$U#i3 1 2 3], "b":[[$S#i2 i1'x' i1'y' ] {$i#i1 i1'c' 5} {i1'd' Z}], "e":T}
+        std::vector<uint8_t> data = {'{',
+                                     'i',1,'a','[','$','U','#','i',3,1,2,3,
+                                     'i',1,'b','[','[','$','S','#','i',2,'i',1,'x','i',1,'y',
+                                                   '{','$','i','#','i',1,'i',1,'c',5,
+                                                   '{','i',1,'d','Z','}',
+                                                   ']',
+                                     'i',1,'e','T',
+                                     '}'};
+        ubjson::ubjson_bytes_cursor cursor1(data);
+        ubjson::ubjson_bytes_cursor cursor2(data);
+        auto expected = events_after_skip(cursor2, false);
+        CHECK(events_after_skip(cursor1, true) == expected);
+        CHECK(expected.size() == 7);
+    }
+
+    SECTION("unexpected eof")
+    {
+        std::vector<uint8_t> data = {'[','[','$','U','#','i',3,1,2};
+        ubjson::ubjson_bytes_cursor cursor(data);
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == ubjson::ubjson_errc::unexpected_eof);
+    }
+}